@@ -103,6 +103,56 @@ static int GenerateProgram(panda::pandasm::Program *prog, const std::string &out
     return 0;
 }
 
+static void PrintErrors(const es2panda::Compiler &compiler, const std::string &fileName)
+{
+    for (const auto &it : compiler.GetErrors()) {
+        std::cout << it.TypeString() << ": " << it.Message();
+        std::cout << " [" << fileName << ":" << it.Line() << ":" << it.Col() << "]" << std::endl;
+    }
+}
+
+// Each module is written next to its source, except the entry module which goes to the requested output
+static std::string ModuleOutput(const std::string &fileName)
+{
+    auto dot = fileName.find_last_of('.');
+    auto slash = fileName.find_last_of('/');
+    bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    return (hasExtension ? fileName.substr(0, dot) : fileName) + ".abc";
+}
+
+static int CompileProject(es2panda::Compiler *compiler, const Options *options)
+{
+    es2panda::SourceFile input(options->SourceFile(), options->ParserInput(), true);
+
+    auto modules = compiler->CompileProject(input, options->CompilerOptions());
+
+    if (modules.empty()) {
+        const auto &err = compiler->GetError();
+
+        if (err.Message().empty() && options->ParseOnly()) {
+            return 0;
+        }
+
+        PrintErrors(*compiler, compiler->GetErrorFile());
+        return err.ErrorCode();
+    }
+
+    int result = 0;
+
+    for (size_t i = 0; i < modules.size(); i++) {
+        const auto &output = i == 0 ? options->CompilerOutput() : ModuleOutput(modules[i].fileName);
+
+        if (GenerateProgram(modules[i].program, output, options->OptLevel(), options->CompilerOptions().dumpAsm,
+                            options->SizeStat()) != 0) {
+            result = 1;
+        }
+
+        delete modules[i].program;
+    }
+
+    return result;
+}
+
 int Run(int argc, const char **argv)
 {
     auto options = std::make_unique<Options>();
@@ -113,6 +163,11 @@ int Run(int argc, const char **argv)
     }
 
     es2panda::Compiler compiler(options->Extension(), options->ThreadCount());
+
+    if (options->Project()) {
+        return CompileProject(&compiler, options.get());
+    }
+
     es2panda::SourceFile input(options->SourceFile(), options->ParserInput(), options->ParseModule());
 
     auto *program = compiler.Compile(input, options->CompilerOptions());
@@ -124,9 +179,7 @@ int Run(int argc, const char **argv)
             return 0;
         }
 
-        std::cout << err.TypeString() << ": " << err.Message();
-        std::cout << " [" << options->SourceFile() << ":" << err.Line() << ":" << err.Col() << "]" << std::endl;
-
+        PrintErrors(compiler, options->SourceFile());
         return err.ErrorCode();
     }
 
@@ -17,6 +17,7 @@
 
 #include <utils/pandargs.h>
 
+#include <limits>
 #include <utility>
 
 namespace panda::es2panda::aot {
@@ -51,8 +52,18 @@ bool Options::Parse(int argc, const char **argv)
     panda::PandArg<std::string> inputExtension("extension", "js",
                                                "Parse the input as the given extension (options: js | ts | as)");
     panda::PandArg<bool> opModule("module", false, "Parse the input as module");
+    panda::PandArg<bool> opProject("project", false,
+                                   "Compile the input module and the modules it reaches through relative specifiers, "
+                                   "exports which none of them imports are removed");
     panda::PandArg<bool> opParseOnly("parse-only", false, "Parse the input only");
     panda::PandArg<bool> opDumpAst("dump-ast", false, "Dump the parsed AST");
+    panda::PandArg<std::string> opAstSnapshot("dump-ast-snapshot", "",
+                                              "Write the binary snapshot of the parsed AST to the given file, "
+                                              "with --dump-ast the AST is dumped as loaded back from the snapshot");
+    panda::PandArg<bool> opSkipTypeCheck("skip-type-check", false, "Compile TypeScript input without type checking");
+    panda::PandArg<bool> opRecordType("record-type", false,
+                                      "Record the checked types of TypeScript variables for the AOT compiler");
+    panda::PandArg<int> opMaxErrors("max-errors", 1, "Maximum number of reported errors, 0 reports all of them");
 
     // compiler
     panda::PandArg<bool> opDumpAssembly("dump-assembly", false, "Dump pandasm");
@@ -61,6 +72,8 @@ bool Options::Parse(int argc, const char **argv)
     panda::PandArg<int> opOptLevel("opt-level", 0, "Compiler optimization level (options: 0 | 1 | 2)");
     panda::PandArg<int> opThreadCount("thread", 0, "Number of worker theads");
     panda::PandArg<bool> opSizeStat("dump-size-stat", false, "Dump size statistics");
+    panda::PandArg<std::string> opCacheDir("cache-dir", "",
+                                           "Reuse the functions compiled by previous runs from the given directory");
     panda::PandArg<std::string> outputFile("output", "", "Compiler binary output (.abc)");
 
     // tail arguments
@@ -68,8 +81,13 @@ bool Options::Parse(int argc, const char **argv)
 
     argparser_->Add(&opHelp);
     argparser_->Add(&opModule);
+    argparser_->Add(&opProject);
     argparser_->Add(&opDumpAst);
+    argparser_->Add(&opAstSnapshot);
     argparser_->Add(&opParseOnly);
+    argparser_->Add(&opSkipTypeCheck);
+    argparser_->Add(&opRecordType);
+    argparser_->Add(&opMaxErrors);
     argparser_->Add(&opDumpAssembly);
     argparser_->Add(&opDebugInfo);
     argparser_->Add(&opDumpDebugInfo);
@@ -77,6 +95,7 @@ bool Options::Parse(int argc, const char **argv)
     argparser_->Add(&opOptLevel);
     argparser_->Add(&opThreadCount);
     argparser_->Add(&opSizeStat);
+    argparser_->Add(&opCacheDir);
 
     argparser_->Add(&inputExtension);
     argparser_->Add(&outputFile);
@@ -113,7 +132,10 @@ bool Options::Parse(int argc, const char **argv)
     ss << inputStream.rdbuf();
     parserInput_ = ss.str();
 
-    sourceFile_ = BaseName(sourceFile_);
+    /* Modules of a project are resolved relative to the path of the entry module */
+    if (!opProject.GetValue()) {
+        sourceFile_ = BaseName(sourceFile_);
+    }
 
     if (!outputFile.GetValue().empty()) {
         compilerOutput_ = outputFile.GetValue();
@@ -143,10 +165,14 @@ bool Options::Parse(int argc, const char **argv)
         options_ |= OptionFlags::PARSE_ONLY;
     }
 
-    if (opModule.GetValue()) {
+    if (opModule.GetValue() || opProject.GetValue()) {
         options_ |= OptionFlags::PARSE_MODULE;
     }
 
+    if (opProject.GetValue()) {
+        options_ |= OptionFlags::PROJECT;
+    }
+
     if (opSizeStat.GetValue()) {
         options_ |= OptionFlags::SIZE_STAT;
     }
@@ -156,6 +182,18 @@ bool Options::Parse(int argc, const char **argv)
     compilerOptions_.dumpDebugInfo = opDumpDebugInfo.GetValue();
     compilerOptions_.isDebug = opDebugInfo.GetValue();
     compilerOptions_.parseOnly = opParseOnly.GetValue();
+    compilerOptions_.skipTypeCheck = opSkipTypeCheck.GetValue();
+    compilerOptions_.recordType = opRecordType.GetValue() && extension_ == es2panda::ScriptExtension::TS;
+    compilerOptions_.cacheDir = opCacheDir.GetValue();
+    compilerOptions_.astSnapshot = opAstSnapshot.GetValue();
+
+    if (opMaxErrors.GetValue() < 0) {
+        errorMsg_ = "Invalid max-errors value";
+        return false;
+    }
+
+    compilerOptions_.maxErrors =
+        opMaxErrors.GetValue() == 0 ? std::numeric_limits<size_t>::max() : static_cast<size_t>(opMaxErrors.GetValue());
 
     return true;
 }
@@ -35,6 +35,7 @@ enum class OptionFlags {
     PARSE_ONLY = 1 << 1,
     PARSE_MODULE = 1 << 2,
     SIZE_STAT = 1 << 3,
+    PROJECT = 1 << 4,
 };
 
 inline std::underlying_type_t<OptionFlags> operator&(OptionFlags a, OptionFlags b)
@@ -115,6 +116,11 @@ public:
         return (options_ & OptionFlags::SIZE_STAT) != 0;
     }
 
+    bool Project() const
+    {
+        return (options_ & OptionFlags::PROJECT) != 0;
+    }
+
 private:
     es2panda::ScriptExtension extension_ {es2panda::ScriptExtension::JS};
     es2panda::CompilerOptions compilerOptions_ {};
@@ -40,6 +40,12 @@
 #include <ir/statements/variableDeclaration.h>
 #include <ir/statements/variableDeclarator.h>
 #include <ir/statements/whileStatement.h>
+#include <ir/ts/tsEnumDeclaration.h>
+#include <ir/ts/tsImportEqualsDeclaration.h>
+#include <ir/ts/tsModuleBlock.h>
+#include <ir/ts/tsModuleDeclaration.h>
+
+#include <algorithm>
 
 namespace panda::es2panda::binder {
 void Binder::InitTopScope()
@@ -158,6 +164,14 @@ void Binder::LookupIdentReference(ir::Identifier *ident)
     ident->SetVariable(res.variable);
 }
 
+void Binder::RemoveFunction(const FunctionScope *funcScope)
+{
+    auto iter = std::find(functionScopes_.begin(), functionScopes_.end(), funcScope);
+    if (iter != functionScopes_.end()) {
+        functionScopes_.erase(iter);
+    }
+}
+
 void Binder::BuildFunction(FunctionScope *funcScope, util::StringView name)
 {
     uint32_t idx = functionScopes_.size();
@@ -177,6 +191,11 @@ void Binder::BuildScriptFunction(Scope *outerScope, const ir::ScriptFunction *sc
         outerVarScope->AddFlag(VariableScopeFlags::INNER_ARROW);
     }
 
+    // Overload signatures and ambient declarations have no code to compile
+    if (scriptFunc->Body() == nullptr) {
+        return;
+    }
+
     BuildFunction(scope_->AsFunctionScope(), util::Helpers::FunctionName(scriptFunc));
 }
 
@@ -269,9 +288,27 @@ void Binder::BuildClassDefinition(ir::ClassDefinition *classDef)
     }
 }
 
+static bool ContainsFunction(const ir::AstNode *node)
+{
+    bool found = false;
+
+    node->Iterate([&found](const ir::AstNode *childNode) {
+        found = found || childNode->IsScriptFunction() || ContainsFunction(childNode);
+    });
+
+    return found;
+}
+
 void Binder::BuildForUpdateLoop(ir::ForUpdateStatement *forUpdateStmt)
 {
     auto *loopScope = forUpdateStmt->Scope();
+    loopScope->RecordOuterSlots();
+
+    /* Closures created there address the slots the bindings were declared with, not the compacted ones */
+    if ((forUpdateStmt->Test() && ContainsFunction(forUpdateStmt->Test())) ||
+        (forUpdateStmt->Update() && ContainsFunction(forUpdateStmt->Update()))) {
+        loopScope->KeepDeclarationSlots();
+    }
 
     auto declScopeCtx = LexicalScope<LoopDeclarationScope>::Enter(this, loopScope->DeclScope());
 
@@ -297,6 +334,7 @@ void Binder::BuildForUpdateLoop(ir::ForUpdateStatement *forUpdateStmt)
 void Binder::BuildForInOfLoop(const ir::Statement *parent, binder::LoopScope *loopScope, ir::AstNode *left,
                               ir::Expression *right, ir::Statement *body)
 {
+    loopScope->RecordOuterSlots();
     auto declScopeCtx = LexicalScope<LoopDeclarationScope>::Enter(this, loopScope->DeclScope());
 
     ResolveReference(parent, right);
@@ -319,6 +357,29 @@ void Binder::BuildCatchClause(ir::CatchClause *catchClauseStmt)
     ResolveReference(catchClauseStmt, catchClauseStmt->Body());
 }
 
+void Binder::BuildTSEnumDeclaration(const ir::TSEnumDeclaration *enumDecl)
+{
+    // The name refers to the enum object outside, the initializers see the members of the enum
+    enumDecl->Iterate([this, enumDecl](auto *childNode) {
+        if (childNode == enumDecl->Key()) {
+            ResolveReference(enumDecl, childNode);
+            return;
+        }
+
+        auto scopeCtx = LexicalScope<LocalScope>::Enter(this, enumDecl->Scope());
+        ResolveReference(enumDecl, childNode);
+    });
+}
+
+void Binder::BuildTSImportEqualsDeclaration(const ir::TSImportEqualsDeclaration *importEqualsDecl)
+{
+    ResolveReferences(importEqualsDecl);
+
+    auto *variable = scope_->FindLocal(importEqualsDecl->Id()->Name());
+    ASSERT(variable && variable->Declaration()->IsConstDecl());
+    variable->AddFlag(VariableFlags::INITIALIZED);
+}
+
 void Binder::ResolveReference(const ir::AstNode *parent, ir::AstNode *childNode)
 {
     childNode->SetParent(parent);
@@ -430,6 +491,26 @@ void Binder::ResolveReference(const ir::AstNode *parent, ir::AstNode *childNode)
             BuildCatchClause(childNode->AsCatchClause());
             break;
         }
+        case ir::AstNodeType::TS_ENUM_DECLARATION: {
+            BuildTSEnumDeclaration(childNode->AsTSEnumDeclaration());
+            break;
+        }
+        case ir::AstNodeType::TS_MODULE_DECLARATION: {
+            auto scopeCtx = LexicalScope<LocalScope>::Enter(this, childNode->AsTSModuleDeclaration()->Scope());
+
+            ResolveReferences(childNode);
+            break;
+        }
+        case ir::AstNodeType::TS_MODULE_BLOCK: {
+            auto scopeCtx = LexicalScope<LocalScope>::Enter(this, childNode->AsTSModuleBlock()->Scope());
+
+            ResolveReferences(childNode);
+            break;
+        }
+        case ir::AstNodeType::TS_IMPORT_EQUALS_DECLARATION: {
+            BuildTSImportEqualsDeclaration(childNode->AsTSImportEqualsDeclaration());
+            break;
+        }
         default: {
             ResolveReferences(childNode);
             break;
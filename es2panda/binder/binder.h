@@ -32,6 +32,8 @@ class ForUpdateStatement;
 class Identifier;
 class ScriptFunction;
 class Statement;
+class TSEnumDeclaration;
+class TSImportEqualsDeclaration;
 class VariableDeclarator;
 }  // namespace panda::es2panda::ir
 
@@ -87,6 +89,8 @@ public:
         return functionScopes_;
     }
 
+    void RemoveFunction(const FunctionScope *funcScope);
+
     const parser::Program *Program() const
     {
         return program_;
@@ -130,6 +134,8 @@ private:
     void BuildForInOfLoop(const ir::Statement *parent, binder::LoopScope *loopScope, ir::AstNode *left,
                           ir::Expression *right, ir::Statement *body);
     void BuildCatchClause(ir::CatchClause *catchClauseStmt);
+    void BuildTSEnumDeclaration(const ir::TSEnumDeclaration *enumDecl);
+    void BuildTSImportEqualsDeclaration(const ir::TSImportEqualsDeclaration *importEqualsDecl);
     void LookupIdentReference(ir::Identifier *ident);
     void ResolveReference(const ir::AstNode *parent, ir::AstNode *childNode);
     void ResolveReferences(const ir::AstNode *parent);
@@ -429,6 +429,25 @@ bool ModuleScope::ExportAnalysis()
     return true;
 }
 
+void ModuleScope::RemoveExport(const util::StringView &exportName)
+{
+    removedExports_.insert(exportName);
+
+    for (auto iter = localExports_.begin(); iter != localExports_.end();) {
+        if (iter->second != exportName) {
+            ++iter;
+            continue;
+        }
+
+        Variable *variable = iter->first;
+        iter = localExports_.erase(iter);
+
+        if (localExports_.find(variable) == localExports_.end()) {
+            variable->RemoveFlag(VariableFlags::LOCAL_EXPORT);
+        }
+    }
+}
+
 // LocalScope
 
 bool LocalScope::AddBinding(ArenaAllocator *allocator, Variable *currentVariable, Decl *newDecl,
@@ -481,11 +500,47 @@ void LoopScope::ConvertToVariableScope(ArenaAllocator *allocator)
         }
     }
 
-    if (loopType_ == ScopeType::LOOP) {
+    if (loopType_ == ScopeType::LOOP && !CompactPerIterationSlots()) {
         slotIndex_ = std::max(slotIndex_, declScope_->LexicalSlots());
     }
 }
 
+bool LoopScope::CompactPerIterationSlots()
+{
+    // Captured bindings declared inside the loop got their slots from the enclosing function while the loop was
+    // resolved. If the per-iteration copies are the only ones, they occupy exactly the slots allocated since
+    // RecordOuterSlots and can be renumbered from zero, so each iteration only copies the captured bindings.
+    if (keepDeclarationSlots_) {
+        return false;
+    }
+
+    uint32_t perIteration = 0;
+
+    for (const auto &[_, var] : bindings_) {
+        (void)_;
+        if (var->HasFlag(VariableFlags::PER_ITERATION)) {
+            perIteration++;
+        }
+    }
+
+    uint32_t allocated = declScope_->Parent()->EnclosingVariableScope()->LexicalSlots() - outerSlots_;
+
+    if (allocated != perIteration) {
+        return false;
+    }
+
+    for (const auto &[_, var] : bindings_) {
+        (void)_;
+        if (var->HasFlag(VariableFlags::PER_ITERATION)) {
+            auto *local = var->AsLocalVariable();
+            local->RebindLexEnvSlot(local->LexIdx() - outerSlots_);
+        }
+    }
+
+    slotIndex_ = perIteration;
+    return true;
+}
+
 bool CatchParamScope::AddBinding(ArenaAllocator *allocator, Variable *currentVariable, Decl *newDecl,
                                  [[maybe_unused]] ScriptExtension extension)
 {
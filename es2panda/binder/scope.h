@@ -529,6 +529,17 @@ public:
         return loopType_;
     }
 
+    void RecordOuterSlots()
+    {
+        outerSlots_ = Parent()->EnclosingVariableScope()->LexicalSlots();
+    }
+
+    // The per-iteration env keeps the layout of the declaration env, see CompactPerIterationSlots
+    void KeepDeclarationSlots()
+    {
+        keepDeclarationSlots_ = true;
+    }
+
     void ConvertToVariableScope(ArenaAllocator *allocator);
 
     bool AddBinding(ArenaAllocator *allocator, Variable *currentVariable, Decl *newDecl,
@@ -538,8 +549,12 @@ public:
     }
 
 protected:
+    bool CompactPerIterationSlots();
+
     LoopDeclarationScope *declScope_ {};
     ScopeType loopType_ {ScopeType::LOCAL};
+    uint32_t outerSlots_ {};
+    bool keepDeclarationSlots_ {false};
 };
 
 class GlobalScope : public FunctionScope {
@@ -572,7 +587,8 @@ public:
           allocator_(allocator),
           imports_(allocator_->Adapter()),
           exports_(allocator_->Adapter()),
-          localExports_(allocator_->Adapter())
+          localExports_(allocator_->Adapter()),
+          removedExports_(allocator_->Adapter())
     {
     }
 
@@ -607,6 +623,14 @@ public:
 
     bool ExportAnalysis();
 
+    // Drops an export which no module of the project imports, its binding is no longer stored to the module
+    void RemoveExport(const util::StringView &exportName);
+
+    bool IsRemovedExport(const util::StringView &exportName) const
+    {
+        return removedExports_.find(exportName) != removedExports_.end();
+    }
+
 private:
     bool AddImport(ArenaAllocator *allocator, Variable *currentVariable, Decl *newDecl);
 
@@ -614,6 +638,7 @@ private:
     ModuleEntry<const ir::ImportDeclaration *, ImportDeclList> imports_;
     ModuleEntry<const ir::AstNode *, ExportDeclList> exports_;
     LocalExportNameMap localExports_;
+    ArenaSet<util::StringView> removedExports_;
 };
 
 template <typename T>
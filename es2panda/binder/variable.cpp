@@ -46,6 +46,9 @@ void LocalVariable::SetLexical(Scope *scope)
         return;
     }
 
+    // Block and catch scopes are not variable scopes, so their captured bindings get a slot in the environment
+    // of the enclosing function. Only loops with per-iteration bindings create an environment of their own,
+    // which does not exist yet while references are resolved.
     VariableScope *varScope = scope->EnclosingVariableScope();
 
     BindLexEnvSlot(varScope->NextSlot());
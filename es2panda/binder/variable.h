@@ -28,6 +28,10 @@ namespace panda::es2panda::checker {
 class Type;
 }  // namespace panda::es2panda::checker
 
+namespace panda::es2panda::ir {
+class Expression;
+}  // namespace panda::es2panda::ir
+
 namespace panda::es2panda::binder {
 
 class Decl;
@@ -143,6 +147,12 @@ public:
         vreg_ = slot;
     }
 
+    void RebindLexEnvSlot(uint32_t slot)
+    {
+        ASSERT(LexicalBound());
+        vreg_ = slot;
+    }
+
     compiler::VReg Vreg() const
     {
         return vreg_;
@@ -202,11 +212,23 @@ public:
         return exoticName_;
     }
 
+    // Constant initializer of the imported binding, set when the exporting module is compiled in the same project
+    const ir::Expression *PropagatedValue() const
+    {
+        return propagatedValue_;
+    }
+
+    void SetPropagatedValue(const ir::Expression *value)
+    {
+        propagatedValue_ = value;
+    }
+
     void SetLexical([[maybe_unused]] Scope *scope) override;
 
 private:
     compiler::VReg moduleReg_ {};
     util::StringView exoticName_ {};
+    const ir::Expression *propagatedValue_ {};
 };
 
 class EnumVariable : public Variable {
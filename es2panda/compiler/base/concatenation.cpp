@@ -0,0 +1,263 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "concatenation.h"
+
+#include <compiler/base/constantFolding.h>
+#include <compiler/core/pandagen.h>
+#include <compiler/core/regScope.h>
+#include <ir/base/templateElement.h>
+#include <ir/expressions/binaryExpression.h>
+#include <ir/expressions/templateLiteral.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace panda::es2panda::compiler {
+
+// Operand of a + chain, node is the addition which has the operand as its right side
+struct ChainOperand {
+    const ir::AstNode *node;
+    const ir::Expression *expr;
+};
+
+// Part of a concatenation, expr is nullptr for constant text
+struct ConcatPart {
+    const ir::AstNode *node;
+    const ir::Expression *expr;
+    std::string str;
+};
+
+using ConcatParts = std::vector<ConcatPart>;
+
+static bool IsAddition(const ir::Expression *expr)
+{
+    return expr->IsBinaryExpression() &&
+           expr->AsBinaryExpression()->OperatorType() == lexer::TokenType::PUNCTUATOR_PLUS;
+}
+
+// Operands of the left-associative chain rooted at expr in evaluation order. Constant subchains are kept as one
+// operand, so that they are still folded.
+static std::vector<ChainOperand> FlattenChain(const ir::BinaryExpression *expr)
+{
+    std::vector<ChainOperand> operands;
+    const ir::Expression *node = expr;
+
+    while (IsAddition(node) && (node == expr || !ConstantFolding::IsConstant(node))) {
+        const auto *binary = node->AsBinaryExpression();
+        operands.push_back({binary, binary->Right()});
+        node = binary->Left();
+    }
+
+    operands.push_back({node, node});
+    std::reverse(operands.begin(), operands.end());
+    return operands;
+}
+
+// Returns true if expr evaluates to the string its parts concatenate to, converting each part right after it is
+// evaluated. The first operand of a chain may only be converted before the second one is evaluated if the second
+// one is a constant.
+static bool CanSplice(const ir::Expression *expr)
+{
+    if (expr->IsTemplateLiteral() || ConstantFolding::IsStringConstant(expr)) {
+        return true;
+    }
+
+    if (!IsAddition(expr)) {
+        return false;
+    }
+
+    auto operands = FlattenChain(expr->AsBinaryExpression());
+    return CanSplice(operands[0].expr) || ConstantFolding::IsStringConstant(operands[1].expr);
+}
+
+static void AddConstant(ConcatParts *parts, const ir::AstNode *node, std::string_view str)
+{
+    if (!parts->empty() && parts->back().expr == nullptr) {
+        parts->back().str.append(str);
+        return;
+    }
+
+    parts->push_back({node, nullptr, std::string(str)});
+}
+
+static void CollectParts(ConcatParts *parts, const ir::Expression *expr);
+
+// Adds an operand of a concatenation whose accumulated value is already a string
+static void CollectOperand(ConcatParts *parts, const ir::AstNode *node, const ir::Expression *expr)
+{
+    std::string str;
+
+    if (ConstantFolding::TryFoldString(expr, &str)) {
+        AddConstant(parts, node, str);
+        return;
+    }
+
+    if (CanSplice(expr)) {
+        CollectParts(parts, expr);
+        return;
+    }
+
+    parts->push_back({node, expr, {}});
+}
+
+static void CollectParts(ConcatParts *parts, const ir::Expression *expr)
+{
+    ASSERT(CanSplice(expr));
+    std::string str;
+
+    if (ConstantFolding::TryFoldString(expr, &str)) {
+        AddConstant(parts, expr, str);
+        return;
+    }
+
+    if (expr->IsTemplateLiteral()) {
+        const auto &quasis = expr->AsTemplateLiteral()->Quasis();
+        const auto &expressions = expr->AsTemplateLiteral()->Expressions();
+
+        for (size_t i = 0; i < quasis.size(); i++) {
+            AddConstant(parts, quasis[i], quasis[i]->Raw().Utf8());
+
+            if (i < expressions.size()) {
+                CollectOperand(parts, expressions[i], expressions[i]);
+            }
+        }
+
+        return;
+    }
+
+    for (const auto &operand : FlattenChain(expr->AsBinaryExpression())) {
+        CollectOperand(parts, operand.node, operand.expr);
+    }
+}
+
+static void LoadConstant(PandaGen *pg, const ConcatPart &part)
+{
+    pg->LoadAccumulatorString(part.node, util::UString(part.str, pg->Allocator()).View());
+}
+
+static void AddPart(PandaGen *pg, VReg lhs, const ConcatPart &part)
+{
+    pg->StoreAccumulator(part.node, lhs);
+
+    if (part.expr != nullptr) {
+        part.expr->Compile(pg);
+    } else {
+        LoadConstant(pg, part);
+    }
+
+    pg->Binary(part.node, lexer::TokenType::PUNCTUATOR_PLUS, lhs);
+}
+
+// Emits the additions of the parts. If isString is not set, the parts start the concatenation and the first
+// addition has to convert the accumulated value to a string.
+static void EmitParts(PandaGen *pg, const ir::AstNode *root, VReg lhs, const ConcatParts &parts, bool isString)
+{
+    ConcatParts nonEmpty;
+
+    for (const auto &part : parts) {
+        if (part.expr != nullptr || !part.str.empty()) {
+            nonEmpty.push_back(part);
+        }
+    }
+
+    auto it = nonEmpty.begin();
+
+    if (!isString) {
+        if (it == nonEmpty.end()) {
+            pg->LoadAccumulatorString(root, "");
+            return;
+        }
+
+        if (it->expr == nullptr) {
+            LoadConstant(pg, *it++);
+        } else if (std::next(it) != nonEmpty.end() && std::next(it)->expr == nullptr) {
+            /* The constant following the expression converts it to a string */
+            it->expr->Compile(pg);
+            AddPart(pg, lhs, *std::next(it));
+            it += 2U;
+        } else {
+            pg->LoadAccumulatorString(root, "");
+            AddPart(pg, lhs, *it++);
+        }
+    }
+
+    for (; it != nonEmpty.end(); ++it) {
+        AddPart(pg, lhs, *it);
+    }
+}
+
+void Concatenation::CompileTemplate(PandaGen *pg, const ir::TemplateLiteral *lit)
+{
+    ConcatParts parts;
+    CollectParts(&parts, lit);
+
+    RegScope rs(pg);
+    VReg lhs = pg->AllocReg();
+    EmitParts(pg, lit, lhs, parts, false);
+}
+
+void Concatenation::CompileChain(PandaGen *pg, const ir::BinaryExpression *expr)
+{
+    auto operands = FlattenChain(expr);
+    ConcatParts parts;
+
+    RegScope rs(pg);
+    VReg lhs = pg->AllocReg();
+
+    if (CanSplice(operands[0].expr)) {
+        for (const auto &operand : operands) {
+            CollectOperand(&parts, operand.node, operand.expr);
+        }
+
+        EmitParts(pg, expr, lhs, parts, false);
+        return;
+    }
+
+    operands[0].expr->Compile(pg);
+    auto it = std::next(operands.begin());
+
+    /* The additions are kept until one of them is known to produce a string */
+    for (; it != operands.end() && !CanSplice(it->expr); ++it) {
+        AddPart(pg, lhs, {it->node, it->expr, {}});
+    }
+
+    if (it == operands.end()) {
+        return;
+    }
+
+    if (ConstantFolding::IsStringConstant(it->expr)) {
+        for (auto rest = it; rest != operands.end(); ++rest) {
+            CollectOperand(&parts, rest->node, rest->expr);
+        }
+
+        /* The joined constant converts the accumulated value to a string, even if it is empty */
+        ASSERT(parts.front().expr == nullptr);
+        AddPart(pg, lhs, parts.front());
+        parts.erase(parts.begin());
+    } else {
+        AddPart(pg, lhs, {it->node, it->expr, {}});
+
+        for (auto rest = std::next(it); rest != operands.end(); ++rest) {
+            CollectOperand(&parts, rest->node, rest->expr);
+        }
+    }
+
+    EmitParts(pg, expr, lhs, parts, true);
+}
+
+}  // namespace panda::es2panda::compiler
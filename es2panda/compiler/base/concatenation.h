@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES2PANDA_COMPILER_BASE_CONCATENATION_H
+#define ES2PANDA_COMPILER_BASE_CONCATENATION_H
+
+namespace panda::es2panda::ir {
+class BinaryExpression;
+class TemplateLiteral;
+}  // namespace panda::es2panda::ir
+
+namespace panda::es2panda::compiler {
+
+class PandaGen;
+
+// Lowers + chains and template literals to one sequence of additions. Once the accumulated value is known to be a
+// string, nested templates and string chains are spliced into the sequence and adjacent constant parts are joined
+// at compile time, so the runtime creates one intermediate string per non-constant part only.
+class Concatenation {
+public:
+    Concatenation() = delete;
+
+    static void CompileTemplate(PandaGen *pg, const ir::TemplateLiteral *lit);
+
+    // expr is a + expression, the + expressions on its left side are compiled with it
+    static void CompileChain(PandaGen *pg, const ir::BinaryExpression *expr);
+};
+
+}  // namespace panda::es2panda::compiler
+
+#endif
@@ -0,0 +1,658 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "constantFolding.h"
+
+#include <compiler/core/pandagen.h>
+#include <ir/base/templateElement.h>
+#include <ir/expressions/binaryExpression.h>
+#include <ir/expressions/conditionalExpression.h>
+#include <ir/expressions/literals/booleanLiteral.h>
+#include <ir/expressions/literals/nullLiteral.h>
+#include <ir/expressions/literals/numberLiteral.h>
+#include <ir/expressions/literals/stringLiteral.h>
+#include <ir/expressions/templateLiteral.h>
+#include <ir/expressions/unaryExpression.h>
+#include <util/helpers.h>
+
+#include <cmath>
+#include <optional>
+#include <string>
+
+namespace panda::es2panda::compiler {
+
+// Deeper expressions are not folded, so that retrying at every level of a long non-constant chain stays cheap
+static constexpr size_t MAX_FOLDING_DEPTH = 32;
+
+enum class ValueKind {
+    NUMBER,
+    STRING,
+    BOOLEAN,
+    NULL_VALUE,
+    UNDEFINED,
+};
+
+struct ConstantValue {
+    ValueKind kind {ValueKind::UNDEFINED};
+    double number {};
+    bool boolean {};
+    std::string str {};
+};
+
+using FoldResult = std::optional<ConstantValue>;
+
+static FoldResult Fold(const ir::Expression *expr, size_t depth);
+
+static ConstantValue MakeNumber(double number)
+{
+    ConstantValue value;
+    value.kind = ValueKind::NUMBER;
+    value.number = number;
+    return value;
+}
+
+static ConstantValue MakeString(std::string str)
+{
+    ConstantValue value;
+    value.kind = ValueKind::STRING;
+    value.str = std::move(str);
+    return value;
+}
+
+static ConstantValue MakeBoolean(bool boolean)
+{
+    ConstantValue value;
+    value.kind = ValueKind::BOOLEAN;
+    value.boolean = boolean;
+    return value;
+}
+
+static ConstantValue MakeKind(ValueKind kind)
+{
+    ConstantValue value;
+    value.kind = kind;
+    return value;
+}
+
+static bool ToBoolean(const ConstantValue &value)
+{
+    switch (value.kind) {
+        case ValueKind::NUMBER: {
+            return !(value.number == 0 || std::isnan(value.number));
+        }
+        case ValueKind::STRING: {
+            return !value.str.empty();
+        }
+        case ValueKind::BOOLEAN: {
+            return value.boolean;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+// String to number conversion follows the StringNumericLiteral grammar, it is left to the runtime
+static std::optional<double> ToNumber(const ConstantValue &value)
+{
+    switch (value.kind) {
+        case ValueKind::NUMBER: {
+            return value.number;
+        }
+        case ValueKind::BOOLEAN: {
+            return value.boolean ? 1 : 0;
+        }
+        case ValueKind::NULL_VALUE: {
+            return 0;
+        }
+        case ValueKind::UNDEFINED: {
+            return std::nan("");
+        }
+        default: {
+            return std::nullopt;
+        }
+    }
+}
+
+static uint32_t ToUint32(double number)
+{
+    if (!std::isfinite(number)) {
+        return 0;
+    }
+
+    constexpr double TWO_POW_32 = 4294967296.0;
+    double res = std::fmod(std::trunc(number), TWO_POW_32);
+
+    if (res < 0) {
+        res += TWO_POW_32;
+    }
+
+    return static_cast<uint32_t>(res);
+}
+
+static int32_t ToInt32(double number)
+{
+    return static_cast<int32_t>(ToUint32(number));
+}
+
+// Only conversions which do not need the shortest round-trip number formatting are folded
+static std::optional<std::string> ToString(const ConstantValue &value)
+{
+    switch (value.kind) {
+        case ValueKind::NUMBER: {
+            if (std::isnan(value.number)) {
+                return "NaN";
+            }
+
+            if (std::isinf(value.number)) {
+                return value.number > 0 ? "Infinity" : "-Infinity";
+            }
+
+            if (util::Helpers::IsInteger<int32_t>(value.number)) {
+                return std::to_string(static_cast<int32_t>(value.number));
+            }
+
+            return std::nullopt;
+        }
+        case ValueKind::STRING: {
+            return value.str;
+        }
+        case ValueKind::BOOLEAN: {
+            return value.boolean ? "true" : "false";
+        }
+        case ValueKind::NULL_VALUE: {
+            return "null";
+        }
+        default: {
+            return "undefined";
+        }
+    }
+}
+
+static const char *TypeOf(const ConstantValue &value)
+{
+    switch (value.kind) {
+        case ValueKind::NUMBER: {
+            return "number";
+        }
+        case ValueKind::STRING: {
+            return "string";
+        }
+        case ValueKind::BOOLEAN: {
+            return "boolean";
+        }
+        case ValueKind::NULL_VALUE: {
+            return "object";
+        }
+        default: {
+            return "undefined";
+        }
+    }
+}
+
+static bool StrictEquals(const ConstantValue &lhs, const ConstantValue &rhs)
+{
+    if (lhs.kind != rhs.kind) {
+        return false;
+    }
+
+    switch (lhs.kind) {
+        case ValueKind::NUMBER: {
+            return lhs.number == rhs.number;
+        }
+        case ValueKind::STRING: {
+            return lhs.str == rhs.str;
+        }
+        case ValueKind::BOOLEAN: {
+            return lhs.boolean == rhs.boolean;
+        }
+        default: {
+            return true;
+        }
+    }
+}
+
+static std::optional<bool> LooseEquals(const ConstantValue &lhs, const ConstantValue &rhs)
+{
+    if (lhs.kind == rhs.kind) {
+        return StrictEquals(lhs, rhs);
+    }
+
+    bool lhsNullish = lhs.kind == ValueKind::NULL_VALUE || lhs.kind == ValueKind::UNDEFINED;
+    bool rhsNullish = rhs.kind == ValueKind::NULL_VALUE || rhs.kind == ValueKind::UNDEFINED;
+
+    if (lhsNullish || rhsNullish) {
+        return lhsNullish && rhsNullish;
+    }
+
+    if (lhs.kind == ValueKind::STRING || rhs.kind == ValueKind::STRING) {
+        return std::nullopt;
+    }
+
+    return *ToNumber(lhs) == *ToNumber(rhs);
+}
+
+static double Exponentiate(double base, double exponent)
+{
+    // Math.pow differs from std::pow for these cases
+    if (std::isnan(exponent) || (std::fabs(base) == 1 && std::isinf(exponent))) {
+        return std::nan("");
+    }
+
+    return std::pow(base, exponent);
+}
+
+static FoldResult FoldArithmetic(lexer::TokenType op, double lhs, double rhs)
+{
+    switch (op) {
+        case lexer::TokenType::PUNCTUATOR_PLUS: {
+            return MakeNumber(lhs + rhs);
+        }
+        case lexer::TokenType::PUNCTUATOR_MINUS: {
+            return MakeNumber(lhs - rhs);
+        }
+        case lexer::TokenType::PUNCTUATOR_MULTIPLY: {
+            return MakeNumber(lhs * rhs);
+        }
+        case lexer::TokenType::PUNCTUATOR_DIVIDE: {
+            return MakeNumber(lhs / rhs);
+        }
+        case lexer::TokenType::PUNCTUATOR_MOD: {
+            return MakeNumber(std::fmod(lhs, rhs));
+        }
+        case lexer::TokenType::PUNCTUATOR_EXPONENTIATION: {
+            return MakeNumber(Exponentiate(lhs, rhs));
+        }
+        case lexer::TokenType::PUNCTUATOR_LEFT_SHIFT: {
+            constexpr uint32_t SHIFT_MASK = 0x1F;
+            return MakeNumber(static_cast<int32_t>(ToUint32(lhs) << (ToUint32(rhs) & SHIFT_MASK)));
+        }
+        case lexer::TokenType::PUNCTUATOR_RIGHT_SHIFT: {
+            constexpr uint32_t SHIFT_MASK = 0x1F;
+            return MakeNumber(ToInt32(lhs) >> (ToUint32(rhs) & SHIFT_MASK));
+        }
+        case lexer::TokenType::PUNCTUATOR_UNSIGNED_RIGHT_SHIFT: {
+            constexpr uint32_t SHIFT_MASK = 0x1F;
+            return MakeNumber(ToUint32(lhs) >> (ToUint32(rhs) & SHIFT_MASK));
+        }
+        case lexer::TokenType::PUNCTUATOR_BITWISE_AND: {
+            return MakeNumber(ToInt32(lhs) & ToInt32(rhs));
+        }
+        case lexer::TokenType::PUNCTUATOR_BITWISE_OR: {
+            return MakeNumber(ToInt32(lhs) | ToInt32(rhs));
+        }
+        case lexer::TokenType::PUNCTUATOR_BITWISE_XOR: {
+            return MakeNumber(ToInt32(lhs) ^ ToInt32(rhs));
+        }
+        case lexer::TokenType::PUNCTUATOR_LESS_THAN: {
+            return MakeBoolean(lhs < rhs);
+        }
+        case lexer::TokenType::PUNCTUATOR_LESS_THAN_EQUAL: {
+            return MakeBoolean(lhs <= rhs);
+        }
+        case lexer::TokenType::PUNCTUATOR_GREATER_THAN: {
+            return MakeBoolean(lhs > rhs);
+        }
+        case lexer::TokenType::PUNCTUATOR_GREATER_THAN_EQUAL: {
+            return MakeBoolean(lhs >= rhs);
+        }
+        default: {
+            return std::nullopt;
+        }
+    }
+}
+
+static FoldResult FoldBinary(const ir::BinaryExpression *expr, size_t depth)
+{
+    auto lhs = Fold(expr->Left(), depth);
+    if (!lhs) {
+        return std::nullopt;
+    }
+
+    auto rhs = Fold(expr->Right(), depth);
+    if (!rhs) {
+        return std::nullopt;
+    }
+
+    lexer::TokenType op = expr->OperatorType();
+
+    switch (op) {
+        case lexer::TokenType::PUNCTUATOR_LOGICAL_AND: {
+            return ToBoolean(*lhs) ? rhs : lhs;
+        }
+        case lexer::TokenType::PUNCTUATOR_LOGICAL_OR: {
+            return ToBoolean(*lhs) ? lhs : rhs;
+        }
+        case lexer::TokenType::PUNCTUATOR_NULLISH_COALESCING: {
+            bool isNullish = lhs->kind == ValueKind::NULL_VALUE || lhs->kind == ValueKind::UNDEFINED;
+            return isNullish ? rhs : lhs;
+        }
+        case lexer::TokenType::PUNCTUATOR_STRICT_EQUAL: {
+            return MakeBoolean(StrictEquals(*lhs, *rhs));
+        }
+        case lexer::TokenType::PUNCTUATOR_NOT_STRICT_EQUAL: {
+            return MakeBoolean(!StrictEquals(*lhs, *rhs));
+        }
+        case lexer::TokenType::PUNCTUATOR_EQUAL:
+        case lexer::TokenType::PUNCTUATOR_NOT_EQUAL: {
+            auto equals = LooseEquals(*lhs, *rhs);
+            if (!equals) {
+                return std::nullopt;
+            }
+
+            return MakeBoolean(op == lexer::TokenType::PUNCTUATOR_EQUAL ? *equals : !*equals);
+        }
+        case lexer::TokenType::PUNCTUATOR_PLUS: {
+            if (lhs->kind != ValueKind::STRING && rhs->kind != ValueKind::STRING) {
+                break;
+            }
+
+            auto lhsStr = ToString(*lhs);
+            auto rhsStr = ToString(*rhs);
+            if (!lhsStr || !rhsStr) {
+                return std::nullopt;
+            }
+
+            return MakeString(*lhsStr + *rhsStr);
+        }
+        default: {
+            break;
+        }
+    }
+
+    auto lhsNum = ToNumber(*lhs);
+    auto rhsNum = ToNumber(*rhs);
+    if (!lhsNum || !rhsNum) {
+        return std::nullopt;
+    }
+
+    return FoldArithmetic(op, *lhsNum, *rhsNum);
+}
+
+static FoldResult FoldUnary(const ir::UnaryExpression *expr, size_t depth)
+{
+    auto arg = Fold(expr->Argument(), depth);
+    if (!arg) {
+        return std::nullopt;
+    }
+
+    switch (expr->OperatorType()) {
+        case lexer::TokenType::PUNCTUATOR_EXCLAMATION_MARK: {
+            return MakeBoolean(!ToBoolean(*arg));
+        }
+        case lexer::TokenType::KEYW_VOID: {
+            return MakeKind(ValueKind::UNDEFINED);
+        }
+        case lexer::TokenType::KEYW_TYPEOF: {
+            return MakeString(TypeOf(*arg));
+        }
+        default: {
+            break;
+        }
+    }
+
+    auto num = ToNumber(*arg);
+    if (!num) {
+        return std::nullopt;
+    }
+
+    switch (expr->OperatorType()) {
+        case lexer::TokenType::PUNCTUATOR_PLUS: {
+            return MakeNumber(*num);
+        }
+        case lexer::TokenType::PUNCTUATOR_MINUS: {
+            return MakeNumber(-*num);
+        }
+        case lexer::TokenType::PUNCTUATOR_TILDE: {
+            return MakeNumber(~ToInt32(*num));
+        }
+        default: {
+            return std::nullopt;
+        }
+    }
+}
+
+static FoldResult FoldTemplate(const ir::TemplateLiteral *expr, size_t depth)
+{
+    const auto &quasis = expr->Quasis();
+    const auto &expressions = expr->Expressions();
+    std::string str;
+
+    for (size_t i = 0; i < quasis.size(); i++) {
+        // TemplateLiteral::Compile loads the raw strings, only fold when both views agree
+        if (quasis[i]->Raw() != quasis[i]->Cooked()) {
+            return std::nullopt;
+        }
+
+        str += quasis[i]->Raw().Utf8();
+
+        if (i >= expressions.size()) {
+            continue;
+        }
+
+        auto value = Fold(expressions[i], depth);
+        if (!value) {
+            return std::nullopt;
+        }
+
+        auto valueStr = ToString(*value);
+        if (!valueStr) {
+            return std::nullopt;
+        }
+
+        str += *valueStr;
+    }
+
+    return MakeString(std::move(str));
+}
+
+static FoldResult Fold(const ir::Expression *expr, size_t depth)
+{
+    if (++depth > MAX_FOLDING_DEPTH) {
+        return std::nullopt;
+    }
+
+    switch (expr->Type()) {
+        case ir::AstNodeType::NUMBER_LITERAL: {
+            return MakeNumber(expr->AsNumberLiteral()->Number<double>());
+        }
+        case ir::AstNodeType::STRING_LITERAL: {
+            return MakeString(std::string(expr->AsStringLiteral()->Str().Utf8()));
+        }
+        case ir::AstNodeType::BOOLEAN_LITERAL: {
+            return MakeBoolean(expr->AsBooleanLiteral()->Value());
+        }
+        case ir::AstNodeType::NULL_LITERAL: {
+            return MakeKind(ValueKind::NULL_VALUE);
+        }
+        case ir::AstNodeType::BINARY_EXPRESSION: {
+            return FoldBinary(expr->AsBinaryExpression(), depth);
+        }
+        case ir::AstNodeType::UNARY_EXPRESSION: {
+            return FoldUnary(expr->AsUnaryExpression(), depth);
+        }
+        case ir::AstNodeType::TEMPLATE_LITERAL: {
+            return FoldTemplate(expr->AsTemplateLiteral(), depth);
+        }
+        case ir::AstNodeType::CONDITIONAL_EXPRESSION: {
+            const auto *condExpr = expr->AsConditionalExpression();
+            auto test = Fold(condExpr->Test(), depth);
+            if (!test) {
+                return std::nullopt;
+            }
+
+            return Fold(ToBoolean(*test) ? condExpr->Consequent() : condExpr->Alternate(), depth);
+        }
+        default: {
+            return std::nullopt;
+        }
+    }
+}
+
+// Numbers which NumberLiteral cannot load exactly: -0 would be emitted as an integer zero and
+// -Infinity as Infinity
+static bool IsRepresentableNumber(double number)
+{
+    return !(number == 0 && std::signbit(number)) && !(std::isinf(number) && number < 0);
+}
+
+static FoldResult FoldExpression(const ir::Expression *expr)
+{
+    if (expr->IsLiteral()) {
+        // Nothing to gain
+        return std::nullopt;
+    }
+
+    auto value = Fold(expr, 0);
+
+    if (value && value->kind == ValueKind::NUMBER && !IsRepresentableNumber(value->number)) {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+static void LoadValue(PandaGen *pg, const ir::AstNode *node, const ConstantValue &value)
+{
+    switch (value.kind) {
+        case ValueKind::NUMBER: {
+            if (std::isnan(value.number)) {
+                pg->LoadConst(node, Constant::JS_NAN);
+            } else if (!std::isfinite(value.number)) {
+                pg->LoadConst(node, Constant::JS_INFINITY);
+            } else if (util::Helpers::IsInteger<int32_t>(value.number)) {
+                pg->LoadAccumulatorInt(node, static_cast<int32_t>(value.number));
+            } else {
+                pg->LoadAccumulatorFloat(node, value.number);
+            }
+            break;
+        }
+        case ValueKind::STRING: {
+            pg->LoadAccumulatorString(node, util::UString(value.str, pg->Allocator()).View());
+            break;
+        }
+        case ValueKind::BOOLEAN: {
+            pg->LoadConst(node, value.boolean ? Constant::JS_TRUE : Constant::JS_FALSE);
+            break;
+        }
+        case ValueKind::NULL_VALUE: {
+            pg->LoadConst(node, Constant::JS_NULL);
+            break;
+        }
+        default: {
+            pg->LoadConst(node, Constant::JS_UNDEFINED);
+            break;
+        }
+    }
+}
+
+bool ConstantFolding::TryCompile(PandaGen *pg, const ir::Expression *expr)
+{
+    auto value = FoldExpression(expr);
+    if (!value) {
+        return false;
+    }
+
+    LoadValue(pg, expr, *value);
+    return true;
+}
+
+bool ConstantFolding::IsConstant(const ir::Expression *expr)
+{
+    auto value = Fold(expr, 0);
+    return value && (value->kind != ValueKind::NUMBER || IsRepresentableNumber(value->number));
+}
+
+bool ConstantFolding::IsStringConstant(const ir::Expression *expr)
+{
+    auto value = Fold(expr, 0);
+    return value && value->kind == ValueKind::STRING;
+}
+
+bool ConstantFolding::TryFoldString(const ir::Expression *expr, std::string *str)
+{
+    auto value = Fold(expr, 0);
+    if (!value) {
+        return false;
+    }
+
+    auto valueStr = ToString(*value);
+    if (!valueStr) {
+        return false;
+    }
+
+    *str = std::move(*valueStr);
+    return true;
+}
+
+void ConstantFolding::CompileConstant(PandaGen *pg, const ir::AstNode *node, const ir::Expression *expr)
+{
+    auto value = Fold(expr, 0);
+    ASSERT(value);
+    LoadValue(pg, node, *value);
+}
+
+const ir::Literal *ConstantFolding::TryFoldLiteral(PandaGen *pg, const ir::Expression *expr)
+{
+    if (util::Helpers::IsConstantExpr(expr)) {
+        return expr->AsLiteral();
+    }
+
+    auto value = FoldExpression(expr);
+    if (!value) {
+        return nullptr;
+    }
+
+    ir::Literal *lit = nullptr;
+
+    switch (value->kind) {
+        case ValueKind::NUMBER: {
+            lit = pg->Allocator()->New<ir::NumberLiteral>(value->number);
+            break;
+        }
+        case ValueKind::STRING: {
+            lit = pg->Allocator()->New<ir::StringLiteral>(util::UString(value->str, pg->Allocator()).View());
+            break;
+        }
+        case ValueKind::BOOLEAN: {
+            lit = pg->Allocator()->New<ir::BooleanLiteral>(value->boolean);
+            break;
+        }
+        case ValueKind::NULL_VALUE: {
+            lit = pg->Allocator()->New<ir::NullLiteral>();
+            break;
+        }
+        default: {
+            // undefined has no literal buffer representation
+            return nullptr;
+        }
+    }
+
+    lit->SetRange(expr->Range());
+    return lit;
+}
+
+bool ConstantFolding::TryFoldCondition(const ir::Expression *expr, bool *result)
+{
+    auto value = Fold(expr, 0);
+    if (!value) {
+        return false;
+    }
+
+    *result = ToBoolean(*value);
+    return true;
+}
+
+}  // namespace panda::es2panda::compiler
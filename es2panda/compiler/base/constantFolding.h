@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES2PANDA_COMPILER_BASE_CONSTANT_FOLDING_H
+#define ES2PANDA_COMPILER_BASE_CONSTANT_FOLDING_H
+
+#include <ir/expression.h>
+
+#include <string>
+
+namespace panda::es2panda::ir {
+class Literal;
+}  // namespace panda::es2panda::ir
+
+namespace panda::es2panda::compiler {
+
+class PandaGen;
+
+// Evaluates expressions built only from primitive literals with JS semantics at compile time.
+// Expressions whose result cannot be computed exactly are left to the runtime.
+class ConstantFolding {
+public:
+    ConstantFolding() = delete;
+
+    // Loads the folded value of expr into the accumulator, returns false if expr is not a constant
+    static bool TryCompile(PandaGen *pg, const ir::Expression *expr);
+
+    // Returns expr folded into a literal node usable in literal buffers, or nullptr
+    static const ir::Literal *TryFoldLiteral(PandaGen *pg, const ir::Expression *expr);
+
+    // Evaluates the truthiness of expr, returns false if expr is not a constant
+    static bool TryFoldCondition(const ir::Expression *expr, bool *result);
+
+    // Returns true if expr, literals included, always evaluates to the same loadable primitive value
+    static bool IsConstant(const ir::Expression *expr);
+
+    // Returns true if expr, literals included, always evaluates to the same string
+    static bool IsStringConstant(const ir::Expression *expr);
+
+    // Stores the string conversion of the constant expr to str, returns false if expr is not a constant or the
+    // conversion is left to the runtime
+    static bool TryFoldString(const ir::Expression *expr, std::string *str);
+
+    // Loads the value of the constant expr into the accumulator, attributing the load to node
+    static void CompileConstant(PandaGen *pg, const ir::AstNode *node, const ir::Expression *expr);
+};
+
+}  // namespace panda::es2panda::compiler
+
+#endif
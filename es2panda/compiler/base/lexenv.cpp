@@ -126,7 +126,13 @@ static void ExpandStoreNormalVar(PandaGen *pg, const ir::AstNode *node, const bi
         CheckConstAssignment(pg, node, local);
     }
 
-    pg->StoreAccumulator(node, localReg);
+    // A spilled local register makes the allocator emit moves after the sta, so the sta itself is tagged
+    const IRNode *store = pg->StoreAccumulator(node, localReg);
+
+    if (isDecl) {
+        pg->RecordVariableType(store, local);
+    }
+
     StoreLocalExport(pg, node, local);
 }
 
@@ -22,6 +22,60 @@
 
 namespace panda::es2panda::compiler {
 
+// LiteralBuffer
+
+template <typename T>
+static void SerializeValue(std::string *out, T value)
+{
+    out->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void SerializeString(std::string *out, const util::StringView &str)
+{
+    SerializeValue(out, str.Length());
+    out->append(str.Utf8());
+}
+
+std::string LiteralBuffer::Serialize() const
+{
+    std::string out;
+    SerializeValue(&out, static_cast<uint8_t>(kind_));
+
+    for (const auto *literal : literals_) {
+        ir::LiteralTag tag = literal->Tag();
+        SerializeValue(&out, static_cast<uint8_t>(tag));
+
+        switch (tag) {
+            case ir::LiteralTag::BOOLEAN: {
+                SerializeValue(&out, literal->GetBoolean());
+                break;
+            }
+            case ir::LiteralTag::INTEGER: {
+                SerializeValue(&out, literal->GetInt());
+                break;
+            }
+            case ir::LiteralTag::DOUBLE: {
+                SerializeValue(&out, literal->GetDouble());
+                break;
+            }
+            case ir::LiteralTag::STRING: {
+                SerializeString(&out, literal->GetString());
+                break;
+            }
+            case ir::LiteralTag::METHOD:
+            case ir::LiteralTag::GENERATOR_METHOD:
+            case ir::LiteralTag::ASYNC_GENERATOR_METHOD: {
+                SerializeString(&out, literal->GetMethod());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return out;
+}
+
 // Literals
 
 void Literals::GetTemplateObject(PandaGen *pg, const ir::TaggedTemplateExpression *lit)
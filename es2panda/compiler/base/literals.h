@@ -19,6 +19,7 @@
 #include <ir/expressions/literal.h>
 #include <util/ustring.h>
 
+#include <string>
 #include <variant>
 
 namespace panda::es2panda::ir {
@@ -34,6 +35,15 @@ namespace panda::es2panda::compiler {
 
 class PandaGen;
 
+// The instruction creating a value from a literal buffer, the runtime builds its constant pool entry for the buffer
+// according to it
+enum class LiteralBufferKind : uint8_t {
+    OBJECT,
+    OBJECT_WITH_METHODS,
+    ARRAY,
+    CLASS,
+};
+
 class LiteralBuffer {
 public:
     explicit LiteralBuffer(ArenaAllocator *allocator) : literals_(allocator->Adapter()) {}
@@ -41,7 +51,7 @@ public:
     NO_COPY_SEMANTIC(LiteralBuffer);
     NO_MOVE_SEMANTIC(LiteralBuffer);
 
-    void Add(ir::Literal *lit)
+    void Add(const ir::Literal *lit)
     {
         literals_.push_back(lit);
     }
@@ -82,9 +92,18 @@ public:
         index_ = index;
     }
 
+    void SetKind(LiteralBufferKind kind)
+    {
+        kind_ = kind;
+    }
+
+    // Buffers with equal contents are only interchangeable if they are also of the same kind
+    std::string Serialize() const;
+
 private:
     ArenaVector<const ir::Literal *> literals_;
     int32_t index_ {};
+    LiteralBufferKind kind_ {LiteralBufferKind::OBJECT};
 };
 
 class Literals {
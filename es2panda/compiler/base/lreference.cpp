@@ -24,6 +24,10 @@
 #include <ir/expressions/memberExpression.h>
 #include <ir/statements/variableDeclaration.h>
 #include <ir/statements/variableDeclarator.h>
+#include <ir/ts/tsAsExpression.h>
+#include <ir/ts/tsNonNullExpression.h>
+#include <ir/ts/tsParameterProperty.h>
+#include <ir/ts/tsTypeAssertion.h>
 
 namespace panda::es2panda::compiler {
 
@@ -123,6 +127,18 @@ LReference LReference::CreateLRef(PandaGen *pg, const ir::AstNode *node, bool is
         case ir::AstNodeType::REST_ELEMENT: {
             return LReference::CreateLRef(pg, node->AsRestElement()->Argument(), true);
         }
+        case ir::AstNodeType::TS_PARAMETER_PROPERTY: {
+            return LReference::CreateLRef(pg, node->AsTSParameterProperty()->Parameter(), true);
+        }
+        case ir::AstNodeType::TS_AS_EXPRESSION: {
+            return LReference::CreateLRef(pg, node->AsTSAsExpression()->Expr(), isDeclaration);
+        }
+        case ir::AstNodeType::TS_NON_NULL_EXPRESSION: {
+            return LReference::CreateLRef(pg, node->AsTSNonNullExpression()->Expr(), isDeclaration);
+        }
+        case ir::AstNodeType::TS_TYPE_ASSERTION: {
+            return LReference::CreateLRef(pg, node->AsTSTypeAssertion()->GetExpression(), isDeclaration);
+        }
         default: {
             UNREACHABLE();
         }
@@ -20,8 +20,13 @@
 #include <compiler/core/compilerContext.h>
 #include <compiler/core/emitter.h>
 #include <compiler/core/function.h>
+#include <compiler/core/functionCache.h>
 #include <compiler/core/pandagen.h>
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+
 namespace panda::es2panda::compiler {
 
 void CompileJob::Run()
@@ -29,15 +34,35 @@ void CompileJob::Run()
     std::unique_lock<std::mutex> lock(m_);
     cond_.wait(lock, [this] { return dependencies_ == 0; });
 
-    ArenaAllocator allocator(SpaceType::SPACE_TYPE_COMPILER, nullptr, true);
-    PandaGen pg(&allocator, context_, scope_);
+    const auto *cache = context_->Cache();
+    std::optional<FunctionCache::Key> key;
+    std::unique_ptr<CachedFunction> cached;
+
+    if (cache != nullptr) {
+        key = cache->ComputeKey(scope_);
+    }
 
-    Function::Compile(&pg);
+    if (key.has_value()) {
+        cached = cache->Load(*key, scope_, context_);
+    }
 
-    FunctionEmitter funcEmitter(&allocator, &pg);
-    funcEmitter.Generate();
+    if (cached != nullptr) {
+        context_->GetEmitter()->AddCachedFunction(cached.get());
+    } else {
+        ArenaAllocator allocator(SpaceType::SPACE_TYPE_COMPILER, nullptr, true);
+        PandaGen pg(&allocator, context_, scope_);
 
-    context_->GetEmitter()->AddFunction(&funcEmitter);
+        Function::Compile(&pg);
+
+        FunctionEmitter funcEmitter(&allocator, &pg);
+        funcEmitter.Generate();
+
+        if (key.has_value()) {
+            cache->Store(*key, &pg, &funcEmitter);
+        }
+
+        context_->GetEmitter()->AddFunction(&funcEmitter);
+    }
 
     if (dependant_) {
         dependant_->Signal();
@@ -87,6 +112,7 @@ void CompileQueue::Schedule(CompilerContext *context)
 {
     ASSERT(jobsCount_ == 0);
     std::unique_lock<std::mutex> lock(m_);
+    errors_.clear();
     const auto &functions = context->Binder()->Functions();
     jobs_ = new CompileJob[functions.size()]();
 
@@ -121,8 +147,8 @@ void CompileQueue::Consume()
     activeWorkers_++;
 
     while (jobsCount_ > 0) {
-        --jobsCount_;
-        auto &job = jobs_[jobsCount_];
+        size_t index = --jobsCount_;
+        auto &job = jobs_[index];
 
         lock.unlock();
 
@@ -130,7 +156,7 @@ void CompileQueue::Consume()
             job.Run();
         } catch (const Error &e) {
             lock.lock();
-            errors_.push_back(e);
+            jobErrors_.emplace_back(index, e);
             lock.unlock();
         }
 
@@ -146,6 +172,16 @@ void CompileQueue::Wait()
     jobsFinished_.wait(lock, [this]() { return activeWorkers_ == 0 && jobsCount_ == 0; });
     delete[] jobs_;
 
+    /* Workers finish jobs in any order, report errors deterministically */
+    std::sort(jobErrors_.begin(), jobErrors_.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+    for (auto &it : jobErrors_) {
+        errors_.push_back(std::move(it.second));
+    }
+
+    jobErrors_.clear();
+
     if (!errors_.empty()) {
         // NOLINTNEXTLINE
         throw errors_.front();
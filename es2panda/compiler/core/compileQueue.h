@@ -73,10 +73,17 @@ public:
     void Consume();
     void Wait();
 
+    // Errors of the last scheduled jobs, in the order of the functions in the binder
+    const std::vector<Error> &Errors() const
+    {
+        return errors_;
+    }
+
 private:
     static void Worker(CompileQueue *queue);
 
     std::vector<os::thread::native_handle_type> threads_;
+    std::vector<std::pair<size_t, Error>> jobErrors_;
     std::vector<Error> errors_;
     std::mutex m_;
     std::condition_variable jobsAvailable_;
@@ -15,13 +15,39 @@
 
 #include "compilerContext.h"
 
+#include <compiler/base/literals.h>
 #include <compiler/core/emitter.h>
 
 namespace panda::es2panda::compiler {
 
-CompilerContext::CompilerContext(binder::Binder *binder, bool isDebug)
-    : binder_(binder), emitter_(std::make_unique<class Emitter>(this)), isDebug_(isDebug)
+CompilerContext::CompilerContext(binder::Binder *binder, bool isDebug, bool recordType, const FunctionCache *cache)
+    : binder_(binder),
+      emitter_(std::make_unique<class Emitter>(this)),
+      isDebug_(isDebug),
+      recordType_(recordType),
+      cache_(cache)
 {
+    if (recordType_) {
+        emitter_->GenTypeInfoRecord(NewLiteralIndex());
+    }
+}
+
+int32_t CompilerContext::InternLiteralBuffer(const LiteralBuffer *buf, bool *isNew)
+{
+    return InternLiteralBuffer(buf->Serialize(), isNew);
+}
+
+int32_t CompilerContext::InternLiteralBuffer(const std::string &key, bool *isNew)
+{
+    std::lock_guard lock(m_);
+    auto [iter, inserted] = literalBufferIndices_.emplace(key, literalBufferIdx_);
+
+    if (inserted) {
+        literalBufferIdx_++;
+    }
+
+    *isNew = inserted;
+    return iter->second;
 }
 
 }  // namespace panda::es2panda::compiler
@@ -21,6 +21,8 @@
 
 #include <cstdint>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace panda::es2panda::binder {
 class Binder;
@@ -30,10 +32,12 @@ namespace panda::es2panda::compiler {
 
 class DebugInfo;
 class Emitter;
+class FunctionCache;
+class LiteralBuffer;
 
 class CompilerContext {
 public:
-    CompilerContext(binder::Binder *binder, bool isDebug);
+    CompilerContext(binder::Binder *binder, bool isDebug, bool recordType, const FunctionCache *cache = nullptr);
     NO_COPY_SEMANTIC(CompilerContext);
     NO_MOVE_SEMANTIC(CompilerContext);
     ~CompilerContext() = default;
@@ -59,6 +63,15 @@ public:
         return literalBufferIdx_++;
     }
 
+    /*
+     * Returns the index of a previously added literal buffer with identical contents, if any.
+     * Otherwise a new index is allocated for the buffer and `isNew` is set.
+     */
+    int32_t InternLiteralBuffer(const LiteralBuffer *buf, bool *isNew);
+
+    // Same as above for a buffer given by its serialized contents, see LiteralBuffer::Serialize
+    int32_t InternLiteralBuffer(const std::string &key, bool *isNew);
+
     std::mutex &Mutex()
     {
         return m_;
@@ -69,12 +82,26 @@ public:
         return isDebug_;
     }
 
+    bool RecordType() const
+    {
+        return recordType_;
+    }
+
+    // Cache of the emitted functions, nullptr if caching is disabled
+    const FunctionCache *Cache() const
+    {
+        return cache_;
+    }
+
 private:
     binder::Binder *binder_;
     std::unique_ptr<Emitter> emitter_;
     int32_t literalBufferIdx_ {0};
+    std::unordered_map<std::string, int32_t> literalBufferIndices_;
     std::mutex m_;
     bool isDebug_;
+    bool recordType_;
+    const FunctionCache *cache_;
 };
 
 }  // namespace panda::es2panda::compiler
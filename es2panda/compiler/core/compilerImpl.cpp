@@ -18,11 +18,13 @@
 #include <compiler/core/compileQueue.h>
 #include <compiler/core/compilerContext.h>
 #include <compiler/core/emitter.h>
+#include <compiler/core/functionCache.h>
 #include <typescript/checker.h>
 #include <es2panda.h>
 #include <parser/program/program.h>
 
 #include <iostream>
+#include <memory>
 #include <thread>
 
 namespace panda::es2panda::compiler {
@@ -36,26 +38,64 @@ CompilerImpl::~CompilerImpl()
 
 panda::pandasm::Program *CompilerImpl::Compile(parser::Program *program, const es2panda::CompilerOptions &options)
 {
-    CompilerContext context(program->Binder(), options.isDebug);
+    /* Recorded types depend on declarations outside of the function, which the cache keys do not cover */
+    std::unique_ptr<FunctionCache> cache;
 
-    if (program->Extension() == ScriptExtension::TS) {
-        ArenaAllocator localAllocator(SpaceType::SPACE_TYPE_COMPILER, nullptr, true);
-        auto checker = std::make_unique<checker::Checker>(&localAllocator, context.Binder());
-        checker->StartChecker();
+    if (!options.cacheDir.empty() && !options.recordType) {
+        cache = std::make_unique<FunctionCache>(options.cacheDir, program->Binder(), options.isDebug);
+    }
+
+    CompilerContext context(program->Binder(), options.isDebug, options.recordType, cache.get());
+    errors_.clear();
+
+    /* Checked types are attached to the variables, they must outlive code generation when types are recorded */
+    ArenaAllocator checkerAllocator(SpaceType::SPACE_TYPE_COMPILER, nullptr, true);
+
+    if (program->Extension() == ScriptExtension::TS && !options.skipTypeCheck) {
+        /* The checker writes flags of binder variables, it must finish before the workers read them */
+        CheckTypes(&checkerAllocator, context.Binder(), options.maxErrors);
 
-        /* TODO(): TS files are not yet compiled */
-        return nullptr;
+        if (!errors_.empty()) {
+            // NOLINTNEXTLINE
+            throw errors_.front();
+        }
     }
 
+    /* TS specific nodes are erased during code generation */
+
     queue_->Schedule(&context);
 
     /* Main thread can also be used instead of idling */
     queue_->Consume();
-    queue_->Wait();
+
+    try {
+        queue_->Wait();
+    } catch (const Error &) {
+        for (const auto &it : queue_->Errors()) {
+            if (errors_.size() >= options.maxErrors) {
+                break;
+            }
+
+            errors_.push_back(it);
+        }
+    }
+
+    if (!errors_.empty()) {
+        // NOLINTNEXTLINE
+        throw errors_.front();
+    }
 
     return context.GetEmitter()->Finalize(options.dumpDebugInfo);
 }
 
+void CompilerImpl::CheckTypes(ArenaAllocator *allocator, binder::Binder *binder, size_t maxErrors)
+{
+    auto checker = std::make_unique<checker::Checker>(allocator, binder);
+
+    checker->StartChecker(maxErrors);
+    errors_ = checker->Errors();
+}
+
 void CompilerImpl::DumpAsm(const panda::pandasm::Program *prog)
 {
     Emitter::DumpAsm(prog);
@@ -22,6 +22,7 @@
 #include <os/thread.h>
 
 #include <string>
+#include <vector>
 
 namespace panda::pandasm {
 struct Program;
@@ -31,6 +32,10 @@ namespace panda::es2panda::parser {
 class Program;
 }  // namespace panda::es2panda::parser
 
+namespace panda::es2panda::binder {
+class Binder;
+}  // namespace panda::es2panda::binder
+
 namespace panda::es2panda::compiler {
 class CompileQueue;
 
@@ -44,8 +49,17 @@ public:
     panda::pandasm::Program *Compile(parser::Program *program, const es2panda::CompilerOptions &options);
     static void DumpAsm(const panda::pandasm::Program *prog);
 
+    // Errors of the last failed Compile call, the first one is also thrown
+    const std::vector<Error> &Errors() const
+    {
+        return errors_;
+    }
+
 private:
+    void CheckTypes(ArenaAllocator *allocator, binder::Binder *binder, size_t maxErrors);
+
     CompileQueue *queue_;
+    std::vector<Error> errors_;
 };
 }  // namespace panda::es2panda::compiler
 
@@ -21,6 +21,7 @@
 #include <binder/variable.h>
 #include <compiler/base/literals.h>
 #include <compiler/core/compilerContext.h>
+#include <compiler/core/functionCache.h>
 #include <compiler/core/pandagen.h>
 #include <compiler/debugger/debuginfoDumper.h>
 #include <compiler/base/catchTable.h>
@@ -31,14 +32,18 @@
 #include <macros.h>
 #include <parser/program/program.h>
 
+#include <limits>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 
 namespace panda::es2panda::compiler {
 
 constexpr const auto LANG_EXT = panda::pandasm::extensions::Language::ECMASCRIPT;
+constexpr const auto TYPE_ANNOTATION_RECORD = "_ESTypeAnnotation";
+constexpr const auto TYPE_ANNOTATION_ELEMENT = "_TypeOfInstruction";
 
 FunctionEmitter::FunctionEmitter(ArenaAllocator *allocator, const PandaGen *pg)
     : pg_(pg), literalBuffers_(allocator->Adapter())
@@ -63,6 +68,7 @@ void FunctionEmitter::Generate()
     GenSourceFileDebugInfo();
     GenFunctionCatchTables();
     GenFunctionICSize();
+    GenFunctionTypeInfo();
     GenLiteralBuffers();
 }
 
@@ -71,10 +77,9 @@ const ArenaSet<util::StringView> &FunctionEmitter::Strings() const
     return pg_->Strings();
 }
 
-void FunctionEmitter::GenBufferLiterals(const LiteralBuffer *buff)
+std::vector<panda::pandasm::LiteralArray::Literal> FunctionEmitter::GenBufferLiterals(const LiteralBuffer *buff)
 {
-    auto &[idx, array] = literalBuffers_.emplace_back();
-    idx = buff->Index();
+    std::vector<panda::pandasm::LiteralArray::Literal> array;
     array.reserve(buff->Literals().size() * 2);
 
     for (const auto *literal : buff->Literals()) {
@@ -139,6 +144,8 @@ void FunctionEmitter::GenBufferLiterals(const LiteralBuffer *buff)
         array.emplace_back(tagLit);
         array.emplace_back(valueLit);
     }
+
+    return array;
 }
 
 util::StringView FunctionEmitter::SourceCode() const
@@ -146,53 +153,17 @@ util::StringView FunctionEmitter::SourceCode() const
     return pg_->Binder()->Program()->SourceCode();
 }
 
-static Format MatchFormat(const IRNode *node, const Formats &formats)
-{
-    std::array<const VReg *, IRNode::MAX_REG_OPERAND> regs {};
-    auto regCnt = node->Registers(&regs);
-    auto registers = Span<const VReg *>(regs.data(), regs.data() + regCnt);
-
-    const auto *iter = formats.begin();
-
-    for (; iter != formats.end(); iter++) {
-        auto format = *iter;
-        size_t limit = 0;
-        for (const auto &formatItem : format.GetFormatItem()) {
-            if (formatItem.IsVReg()) {
-                limit = 1 << formatItem.Bitwidth();
-                break;
-            }
-        }
-
-        if (std::all_of(registers.begin(), registers.end(), [limit](const VReg *reg) { return *reg < limit; })) {
-            return format;
-        }
-    }
-
-    UNREACHABLE();
-    return *iter;
-}
-
-static size_t GetIRNodeWholeLength(const IRNode *node)
+const std::string &FunctionEmitter::WholeLine(const lexer::SourceRange &range)
 {
-    Formats formats = node->GetFormats();
-    if (formats.empty()) {
-        return 0;
-    }
+    auto key = std::make_pair(range.start.index, range.end.index);
+    auto res = wholeLines_.find(key);
 
-    size_t len = 1;
-    const auto format = MatchFormat(node, formats);
-
-    for (auto fi : format.GetFormatItem()) {
-        len += fi.Bitwidth() / 8;
+    if (res == wholeLines_.end()) {
+        auto line = SourceCode().Substr(range.start.index, range.end.index);
+        res = wholeLines_.emplace(key, line.EscapeSymbol<util::StringView::Mutf8Encode>()).first;
     }
 
-    return len;
-}
-
-static std::string WholeLine(const util::StringView &source, lexer::SourceRange range)
-{
-    return source.Substr(range.start.index, range.end.index).EscapeSymbol<util::StringView::Mutf8Encode>();
+    return res->second;
 }
 
 void FunctionEmitter::GenInstructionDebugInfo(const IRNode *ins, panda::pandasm::Ins *pandaIns)
@@ -211,14 +182,14 @@ void FunctionEmitter::GenInstructionDebugInfo(const IRNode *ins, panda::pandasm:
     pandaIns->ins_debug.line_number = astNode->Range().start.line + 1;
 
     if (pg_->IsDebug()) {
-        size_t insLen = GetIRNodeWholeLength(ins);
+        size_t insLen = ins->Size();
         if (insLen != 0) {
             pandaIns->ins_debug.bound_left = offset_;
             pandaIns->ins_debug.bound_right = offset_ + insLen;
         }
 
         offset_ += insLen;
-        pandaIns->ins_debug.whole_line = WholeLine(SourceCode(), astNode->Range());
+        pandaIns->ins_debug.whole_line = WholeLine(astNode->Range());
     }
 }
 
@@ -235,26 +206,67 @@ void FunctionEmitter::GenFunctionInstructions()
 }
 
 void FunctionEmitter::GenFunctionICSize()
+{
+    AddFunctionAnnotation(func_, pg_->IcSize(), pg_->FormalParametersCount(), pg_->FunctionName().Mutf8());
+}
+
+void FunctionEmitter::AddFunctionAnnotation(panda::pandasm::Function *func, uint32_t icSize, uint32_t parameterLength,
+                                            const std::string &funcName)
 {
     panda::pandasm::AnnotationData funcAnnotationData("_ESAnnotation");
     panda::pandasm::AnnotationElement icSizeAnnotationElement(
         "icSize", std::make_unique<panda::pandasm::ScalarValue>(
-                      panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::U32>(pg_->IcSize())));
+                      panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::U32>(icSize)));
     funcAnnotationData.AddElement(std::move(icSizeAnnotationElement));
 
     panda::pandasm::AnnotationElement parameterLengthAnnotationElement(
         "parameterLength",
         std::make_unique<panda::pandasm::ScalarValue>(
-            panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::U32>(pg_->FormalParametersCount())));
+            panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::U32>(parameterLength)));
     funcAnnotationData.AddElement(std::move(parameterLengthAnnotationElement));
 
     panda::pandasm::AnnotationElement funcNameAnnotationElement(
         "funcName",
         std::make_unique<panda::pandasm::ScalarValue>(
-            panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::STRING>(pg_->FunctionName().Mutf8())));
+            panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::STRING>(funcName)));
     funcAnnotationData.AddElement(std::move(funcNameAnnotationElement));
 
-    func_->metadata->AddAnnotations({funcAnnotationData});
+    func->metadata->AddAnnotations({funcAnnotationData});
+}
+
+void FunctionEmitter::GenFunctionTypeInfo()
+{
+    if (pg_->InsnTypes().empty()) {
+        return;
+    }
+
+    /* Same layout as the one produced by ts2abc: pairs of instruction order, labels excluded, and type index */
+    std::vector<panda::pandasm::ScalarValue> elements;
+    auto pandaIns = func_->ins.cbegin();
+    int32_t order = 0;
+
+    for (const auto *ins : pg_->Insns()) {
+        if ((pandaIns++)->opcode == panda::pandasm::Opcode::INVALID) {
+            continue;
+        }
+
+        auto res = pg_->InsnTypes().find(ins);
+
+        if (res != pg_->InsnTypes().end()) {
+            elements.emplace_back(panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::I32>(order));
+            elements.emplace_back(panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::I32>(res->second));
+        }
+
+        order++;
+    }
+
+    panda::pandasm::AnnotationData typeAnnotationData(TYPE_ANNOTATION_RECORD);
+    panda::pandasm::AnnotationElement typeOfInstructionElement(
+        TYPE_ANNOTATION_ELEMENT, std::make_unique<panda::pandasm::ArrayValue>(
+                                     panda::pandasm::Value::Type::I32, std::move(elements)));
+    typeAnnotationData.AddElement(std::move(typeOfInstructionElement));
+
+    func_->metadata->AddAnnotations({typeAnnotationData});
 }
 
 void FunctionEmitter::GenFunctionCatchTables()
@@ -275,7 +287,7 @@ void FunctionEmitter::GenFunctionCatchTables()
 void FunctionEmitter::GenLiteralBuffers()
 {
     for (const auto *buff : pg_->BuffStorage()) {
-        GenBufferLiterals(buff);
+        literalBuffers_.emplace_back(buff->Index(), GenBufferLiterals(buff));
     }
 }
 
@@ -292,38 +304,20 @@ void FunctionEmitter::GenSourceFileDebugInfo()
     }
 }
 
-void FunctionEmitter::GenScopeVariableInfo(const binder::Scope *scope)
+void FunctionEmitter::GenScopeVariableInfo(const binder::Scope *scope, uint32_t start, uint32_t length)
 {
-    const auto *startIns = scope->ScopeStart();
-    const auto *endIns = scope->ScopeEnd();
-
-    uint32_t start = 0;
-    uint32_t count = 0;
-
-    for (const auto *it : pg_->Insns()) {
-        if (startIns == it) {
-            start = count;
-        } else if (endIns == it) {
-            auto varsLength = static_cast<uint32_t>(count - start + 1);
-
-            for (const auto &[name, variable] : scope->Bindings()) {
-                if (!variable->IsLocalVariable() || variable->LexicalBound()) {
-                    continue;
-                }
-
-                auto &variableDebug = func_->local_variable_debug.emplace_back();
-                variableDebug.name = name.Mutf8();
-                variableDebug.signature = "any";
-                variableDebug.signature_type = "any";
-                variableDebug.reg = static_cast<int32_t>(variable->AsLocalVariable()->Vreg());
-                variableDebug.start = start;
-                variableDebug.length = static_cast<uint32_t>(varsLength);
-            }
-
-            break;
+    for (const auto &[name, variable] : scope->Bindings()) {
+        if (!variable->IsLocalVariable() || variable->LexicalBound()) {
+            continue;
         }
 
-        count++;
+        auto &variableDebug = func_->local_variable_debug.emplace_back();
+        variableDebug.name = name.Mutf8();
+        variableDebug.signature = "any";
+        variableDebug.signature_type = "any";
+        variableDebug.reg = static_cast<int32_t>(variable->AsLocalVariable()->Vreg());
+        variableDebug.start = start;
+        variableDebug.length = length;
     }
 }
 
@@ -333,8 +327,38 @@ void FunctionEmitter::GenVariablesDebugInfo()
         return;
     }
 
-    for (const auto *scope : pg_->Debuginfo().variableDebugInfo) {
-        GenScopeVariableInfo(scope);
+    const auto &scopes = pg_->Debuginfo().variableDebugInfo;
+    constexpr auto INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+    // Resolve the start and end instructions of all scopes in a single sweep over the instruction list
+    std::unordered_map<const IRNode *, uint32_t> insIndices;
+    insIndices.reserve(scopes.size() * 2);
+
+    for (const auto *scope : scopes) {
+        insIndices.emplace(scope->ScopeStart(), INVALID_INDEX);
+        insIndices.emplace(scope->ScopeEnd(), INVALID_INDEX);
+    }
+
+    uint32_t count = 0;
+    for (const auto *ins : pg_->Insns()) {
+        auto res = insIndices.find(ins);
+        if (res != insIndices.end()) {
+            res->second = count;
+        }
+
+        count++;
+    }
+
+    for (const auto *scope : scopes) {
+        uint32_t startIndex = insIndices[scope->ScopeStart()];
+        uint32_t endIndex = insIndices[scope->ScopeEnd()];
+
+        if (endIndex == INVALID_INDEX || (startIndex != INVALID_INDEX && startIndex >= endIndex)) {
+            continue;
+        }
+
+        uint32_t start = startIndex == INVALID_INDEX ? 0 : startIndex;
+        GenScopeVariableInfo(scope, start, endIndex - start + 1);
     }
 }
 
@@ -396,12 +420,142 @@ void Emitter::AddFunction(FunctionEmitter *func)
     prog_->function_table.emplace(function->name, std::move(*function));
 }
 
+void Emitter::AddCachedFunction(CachedFunction *func)
+{
+    std::lock_guard<std::mutex> lock(m_);
+
+    for (auto &str : func->strings) {
+        prog_->strings.insert(std::move(str));
+    }
+
+    for (auto &[idx, buf] : func->literalBuffers) {
+        auto literalArrayInstance = panda::pandasm::LiteralArray(std::move(buf));
+        prog_->literalarray_table.emplace(std::to_string(idx), std::move(literalArrayInstance));
+    }
+
+    auto *function = func->function.get();
+    prog_->function_table.emplace(function->name, std::move(*function));
+}
+
+void Emitter::GenTypeInfoRecord(int32_t typeSummaryIndex)
+{
+    auto typeAnnotationRecord = panda::pandasm::Record(TYPE_ANNOTATION_RECORD, LANG_EXT);
+    typeAnnotationRecord.metadata->SetAttribute("external");
+    typeAnnotationRecord.metadata->SetAccessFlags(panda::ACC_ANNOTATION);
+    prog_->record_table.emplace(typeAnnotationRecord.name, std::move(typeAnnotationRecord));
+
+    /* Only builtin types are recorded, so the summary lists no user defined classes and no anonymous types */
+    std::vector<panda::pandasm::LiteralArray::Literal> summary;
+
+    for (uint32_t value : {0U /* counter type tag */, 0U /* user defined classes */, 0U /* anonymous types */}) {
+        panda::pandasm::LiteralArray::Literal tagLit;
+        panda::pandasm::LiteralArray::Literal valueLit;
+
+        tagLit.tag_ = panda::panda_file::LiteralTag::TAGVALUE;
+        tagLit.value_ = static_cast<uint8_t>(panda::panda_file::LiteralTag::INTEGER);
+        valueLit.tag_ = panda::panda_file::LiteralTag::INTEGER;
+        valueLit.value_ = value;
+
+        summary.emplace_back(tagLit);
+        summary.emplace_back(valueLit);
+    }
+
+    prog_->literalarray_table.emplace(std::to_string(typeSummaryIndex), panda::pandasm::LiteralArray(summary));
+
+    auto typeInfoRecord = panda::pandasm::Record("_ESTypeInfoRecord", LANG_EXT);
+    typeInfoRecord.metadata->SetAccessFlags(panda::ACC_PUBLIC);
+
+    auto typeFlagField = panda::pandasm::Field(LANG_EXT);
+    typeFlagField.name = "typeFlag";
+    typeFlagField.type = panda::pandasm::Type("u8", 0);
+    typeFlagField.metadata->SetValue(
+        panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::U8>(static_cast<uint8_t>(1)));
+    typeInfoRecord.field_list.emplace_back(std::move(typeFlagField));
+
+    auto typeSummaryIndexField = panda::pandasm::Field(LANG_EXT);
+    typeSummaryIndexField.name = "typeSummaryIndex";
+    typeSummaryIndexField.type = panda::pandasm::Type("u32", 0);
+    typeSummaryIndexField.metadata->SetValue(
+        panda::pandasm::ScalarValue::Create<panda::pandasm::Value::Type::U32>(static_cast<uint32_t>(typeSummaryIndex)));
+    typeInfoRecord.field_list.emplace_back(std::move(typeSummaryIndexField));
+
+    prog_->record_table.emplace(typeInfoRecord.name, std::move(typeInfoRecord));
+}
+
+bool Emitter::RefersToLiteralBuffer(const panda::pandasm::Ins &ins)
+{
+    switch (ins.opcode) {
+        case panda::pandasm::Opcode::ECMA_CREATEOBJECTWITHBUFFER:
+        case panda::pandasm::Opcode::ECMA_CREATEOBJECTHAVINGMETHOD:
+        case panda::pandasm::Opcode::ECMA_CREATEARRAYWITHBUFFER:
+        case panda::pandasm::Opcode::ECMA_DEFINECLASSWITHBUFFER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void DumpRecord(std::ostream &ss, const panda::pandasm::Record &record)
+{
+    ss << ".record " << record.name << " {" << std::endl;
+
+    for (const auto &field : record.field_list) {
+        ss << "\t" << field.type.GetName() << " " << field.name;
+
+        auto value = field.metadata->GetValue();
+
+        if (value.has_value() && value->GetType() == panda::pandasm::Value::Type::STRING) {
+            ss << " = \"" << value->GetValue<std::string>() << "\"";
+        } else if (value.has_value()) {
+            ss << " = " << value->GetValue<uint64_t>();
+        }
+
+        ss << std::endl;
+    }
+
+    ss << "}" << std::endl << std::endl;
+}
+
+// Type indices recorded by FunctionEmitter::GenFunctionTypeInfo, keyed by instruction order
+static std::unordered_map<int32_t, int32_t> GetInstructionTypes(const panda::pandasm::Function &func)
+{
+    std::unordered_map<int32_t, int32_t> types;
+
+    for (const auto &annotation : func.metadata->GetAnnotations()) {
+        if (annotation.GetName() != TYPE_ANNOTATION_RECORD) {
+            continue;
+        }
+
+        for (const auto &element : annotation.GetElements()) {
+            if (element.GetName() != TYPE_ANNOTATION_ELEMENT) {
+                continue;
+            }
+
+            const auto &values = element.GetValue()->GetAsArray()->GetValues();
+
+            for (size_t i = 0; i + 1 < values.size(); i += 2U) {
+                types.emplace(static_cast<int32_t>(values[i].GetValue<uint64_t>()),
+                              static_cast<int32_t>(values[i + 1].GetValue<uint64_t>()));
+            }
+        }
+    }
+
+    return types;
+}
+
 void Emitter::DumpAsm(const panda::pandasm::Program *prog)
 {
     auto &ss = std::cout;
 
     ss << ".language ECMAScript" << std::endl << std::endl;
 
+    for (const auto &[_, record] : prog->record_table) {
+        (void)_;
+        if (!record.field_list.empty()) {
+            DumpRecord(ss, record);
+        }
+    }
+
     for (auto &[name, func] : prog->function_table) {
         ss << ".function any " << name << '(';
 
@@ -415,8 +569,22 @@ void Emitter::DumpAsm(const panda::pandasm::Program *prog)
 
         ss << ") {" << std::endl;
 
+        auto types = GetInstructionTypes(func);
+        int32_t order = 0;
+
         for (const auto &ins : func.ins) {
-            ss << (ins.set_label ? "" : "\t") << ins.ToString("", true, func.GetTotalRegs()) << std::endl;
+            ss << (ins.set_label ? "" : "\t") << ins.ToString("", true, func.GetTotalRegs());
+
+            /* Labels are not counted by the type annotation */
+            if (ins.opcode != panda::pandasm::Opcode::INVALID) {
+                auto type = types.find(order++);
+
+                if (type != types.end()) {
+                    ss << " # type " << type->second;
+                }
+            }
+
+            ss << std::endl;
         }
 
         ss << "}" << std::endl << std::endl;
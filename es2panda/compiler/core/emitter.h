@@ -23,6 +23,7 @@
 #include <util/ustring.h>
 
 #include <list>
+#include <map>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -51,6 +52,7 @@ class DebugInfo;
 class Label;
 class IRNode;
 class CompilerContext;
+struct CachedFunction;
 
 class FunctionEmitter {
 public:
@@ -72,23 +74,31 @@ public:
     void Generate();
     const ArenaSet<util::StringView> &Strings() const;
 
+    static std::vector<panda::pandasm::LiteralArray::Literal> GenBufferLiterals(const LiteralBuffer *buff);
+    static void AddFunctionAnnotation(panda::pandasm::Function *func, uint32_t icSize, uint32_t parameterLength,
+                                      const std::string &funcName);
+
 private:
     void GenInstructionDebugInfo(const IRNode *ins, panda::pandasm::Ins *pandaIns);
     void GenFunctionInstructions();
     void GenFunctionCatchTables();
     void GenFunctionICSize();
-    void GenScopeVariableInfo(const binder::Scope *scope);
+    void GenFunctionTypeInfo();
+    void GenScopeVariableInfo(const binder::Scope *scope, uint32_t start, uint32_t length);
     void GenSourceFileDebugInfo();
     void GenVariablesDebugInfo();
     util::StringView SourceCode() const;
+    const std::string &WholeLine(const lexer::SourceRange &range);
 
     void GenLiteralBuffers();
-    void GenBufferLiterals(const LiteralBuffer *buff);
 
     const PandaGen *pg_;
     panda::pandasm::Function *func_ {};
     ArenaVector<std::pair<int32_t, std::vector<panda::pandasm::LiteralArray::Literal>>> literalBuffers_;
     size_t offset_ {0};
+    // Escaped source text keyed by node range, so each distinct span is escaped once per function. Every
+    // instruction still gets its own copy, pandasm::Ins owns whole_line by value.
+    std::map<std::pair<size_t, size_t>, std::string> wholeLines_;
 };
 
 class Emitter {
@@ -99,7 +109,12 @@ public:
     NO_MOVE_SEMANTIC(Emitter);
 
     void AddFunction(FunctionEmitter *func);
+    void AddCachedFunction(CachedFunction *func);
+    void GenTypeInfoRecord(int32_t typeSummaryIndex);
     static void DumpAsm(const panda::pandasm::Program *prog);
+
+    // Whether the first immediate of the instruction is the index of a literal array
+    static bool RefersToLiteralBuffer(const panda::pandasm::Ins &ins);
     panda::pandasm::Program *Finalize(bool dumpDebugInfo);
 
 private:
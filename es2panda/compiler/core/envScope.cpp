@@ -60,13 +60,19 @@ void LoopEnvScope::CopyBindings(PandaGen *pg, binder::VariableScope *scope, bind
 
     ASSERT(scope->NeedLexEnv());
 
-    for (const auto &[_, variable] : scope_->Bindings()) {
-        (void)_;
+    for (const auto &[name, variable] : scope_->Bindings()) {
         if (!variable->HasFlag(flag)) {
             continue;
         }
 
-        pg->LoadLexicalVar(scope_->Node(), 1, variable->AsLocalVariable()->LexIdx());
+        // Per-iteration copies may be renumbered in the loop env, read them from the slot of the declaration
+        const auto *source = variable;
+        if (flag == binder::VariableFlags::PER_ITERATION) {
+            source = scope_->Parent()->FindLocal(name);
+            ASSERT(source != nullptr && source->HasFlag(binder::VariableFlags::LOOP_DECL));
+        }
+
+        pg->LoadLexicalVar(scope_->Node(), 1, source->AsLocalVariable()->LexIdx());
         pg->StoreLexicalVar(scope_->Parent()->Node(), 0, variable->AsLocalVariable()->LexIdx());
     }
 }
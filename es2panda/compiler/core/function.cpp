@@ -27,6 +27,9 @@
 #include <ir/expressions/assignmentExpression.h>
 #include <ir/expressions/identifier.h>
 #include <ir/statements/blockStatement.h>
+#include <ir/ts/tsParameterProperty.h>
+
+#include <algorithm>
 
 namespace panda::es2panda::compiler {
 
@@ -124,6 +127,10 @@ static void CompileInstanceFields(PandaGen *pg, const ir::ScriptFunction *decl)
     for (auto const &stmt : statements) {
         if (stmt->IsClassProperty()) {
             const auto *prop = stmt->AsClassProperty();
+            if (prop->Modifiers() & (ir::ModifierFlags::DECLARE | ir::ModifierFlags::ABSTRACT)) {
+                continue;
+            }
+
             if (!prop->Value()) {
                 pg->LoadConst(stmt, Constant::JS_UNDEFINED);
             } else {
@@ -140,12 +147,22 @@ static void CompileInstanceFields(PandaGen *pg, const ir::ScriptFunction *decl)
     }
 }
 
+static bool HasParameterProperties(const ir::ScriptFunction *decl)
+{
+    return std::any_of(decl->Params().begin(), decl->Params().end(),
+                       [](const ir::Expression *param) { return param->IsTSParameterProperty(); });
+}
+
 static void CompileFunction(PandaGen *pg)
 {
     const auto *decl = pg->RootNode()->AsScriptFunction();
 
+    // Field initializers can read parameter properties from this, so they run after the parameters in that case,
+    // like tsc emits them. Otherwise parameter defaults can read the fields.
+    bool fieldsAfterParams = decl->IsConstructor() && HasParameterProperties(decl);
+
     // TODO(szilagyia): move after super call
-    if (decl->IsConstructor()) {
+    if (decl->IsConstructor() && !fieldsAfterParams) {
         CompileInstanceFields(pg, decl);
     }
 
@@ -158,6 +175,15 @@ static void CompileFunction(PandaGen *pg)
 
     CompileFunctionParameterDeclaration(pg, decl);
 
+    // Derived constructors initialize parameter properties once super() has bound this
+    if (decl->IsConstructor() && !util::Helpers::GetClassDefiniton(decl)->Super()) {
+        Function::CompileParameterProperties(pg, decl);
+    }
+
+    if (fieldsAfterParams) {
+        CompileInstanceFields(pg, decl);
+    }
+
     pg->FunctionEnter();
     const ir::AstNode *body = decl->Body();
 
@@ -197,6 +223,42 @@ static VReg CompileFunctionOrProgram(PandaGen *pg)
     return pg->GetEnvScope()->LexEnv();
 }
 
+bool Function::CompileParameterProperties(PandaGen *pg, const ir::ScriptFunction *ctor)
+{
+    RegScope rs(pg);
+    VReg thisReg {};
+    bool hasThis = false;
+
+    for (const auto *param : ctor->Params()) {
+        if (!param->IsTSParameterProperty()) {
+            continue;
+        }
+
+        // The parameter is only addressable from the constructor itself, not from arrows calling super()
+        if (pg->RootNode() != ctor) {
+            PandaGen::Unimplemented();
+        }
+
+        if (!hasThis) {
+            thisReg = pg->AllocReg();
+            pg->GetThis(param);
+            pg->StoreAccumulator(param, thisReg);
+            hasThis = true;
+        }
+
+        const ir::Expression *binding = param->AsTSParameterProperty()->Parameter();
+        if (binding->IsAssignmentPattern()) {
+            binding = binding->AsAssignmentPattern()->Left();
+        }
+
+        const ir::Identifier *ident = binding->AsIdentifier();
+        pg->LoadVar(ident, pg->Scope()->Find(ident->Name()));
+        pg->StoreObjByName(param, thisReg, ident->Name());
+    }
+
+    return hasThis;
+}
+
 void Function::Compile(PandaGen *pg)
 {
     VReg lexEnv = CompileFunctionOrProgram(pg);
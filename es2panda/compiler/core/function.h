@@ -16,6 +16,10 @@
 #ifndef ES2PANDA_COMPILER_CORE_FUNCTION_H
 #define ES2PANDA_COMPILER_CORE_FUNCTION_H
 
+namespace panda::es2panda::ir {
+class ScriptFunction;
+}  // namespace panda::es2panda::ir
+
 namespace panda::es2panda::compiler {
 
 class PandaGen;
@@ -25,6 +29,7 @@ public:
     Function() = delete;
 
     static void Compile(PandaGen *pg);
+    static bool CompileParameterProperties(PandaGen *pg, const ir::ScriptFunction *ctor);
 };
 
 }  // namespace panda::es2panda::compiler
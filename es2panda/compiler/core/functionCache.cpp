@@ -0,0 +1,656 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "functionCache.h"
+
+#include <assembly-program.h>
+#include <binder/binder.h>
+#include <binder/scope.h>
+#include <binder/variable.h>
+#include <compiler/base/literals.h>
+#include <compiler/core/compilerContext.h>
+#include <compiler/core/emitter.h>
+#include <compiler/core/pandagen.h>
+#include <gen/buildId.h>
+#include <ir/base/classDefinition.h>
+#include <ir/base/scriptFunction.h>
+#include <ir/expressions/identifier.h>
+#include <parser/program/program.h>
+#include <util/helpers.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+
+namespace panda::es2panda::compiler {
+
+// Hash of the compiler sources computed by the build, entries written by any other compiler are never matched
+constexpr std::string_view BUILD_ID = ES2PANDA_BUILD_ID;
+constexpr uint64_t ENTRY_MAGIC = 0x3143465041503245;  // "E2PAPFC1"
+
+// Two independent 64 bit hashes: FNV-1a names the entry file, the other one is stored to verify the match
+class KeyHasher {
+public:
+    void Update(std::string_view data)
+    {
+        Update(static_cast<uint64_t>(data.size()));
+
+        for (auto c : data) {
+            UpdateByte(static_cast<uint8_t>(c));
+        }
+    }
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, int> = 0>
+    void Update(T value)
+    {
+        auto bits = static_cast<uint64_t>(value);
+
+        for (size_t i = 0; i < sizeof(uint64_t); i++) {
+            UpdateByte(static_cast<uint8_t>(bits >> (i * 8U)));
+        }
+    }
+
+    void Update(const std::pair<uint64_t, uint64_t> &digest)
+    {
+        Update(digest.first);
+        Update(digest.second);
+    }
+
+    std::pair<uint64_t, uint64_t> Digest() const
+    {
+        return {fnv_, mix_ ^ (mix_ >> 31U)};
+    }
+
+private:
+    void UpdateByte(uint8_t byte)
+    {
+        constexpr uint64_t FNV_PRIME = 0x100000001b3;
+        constexpr uint64_t MIX_MULTIPLIER = 0xc6a4a7935bd1e995;
+
+        fnv_ = (fnv_ ^ byte) * FNV_PRIME;
+        mix_ = (mix_ + byte + 1) * MIX_MULTIPLIER;
+        mix_ ^= mix_ >> 47U;
+    }
+
+    uint64_t fnv_ {0xcbf29ce484222325};
+    uint64_t mix_ {0x9e3779b97f4a7c15};
+};
+
+class EntryWriter {
+public:
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+    void Write(T value)
+    {
+        buffer_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    void Write(std::string_view str)
+    {
+        Write(static_cast<uint64_t>(str.size()));
+        buffer_.append(str);
+    }
+
+    const std::string &Buffer() const
+    {
+        return buffer_;
+    }
+
+private:
+    std::string buffer_;
+};
+
+// Reads past the end, or reads of invalid values, only clear the ok flag
+class EntryReader {
+public:
+    explicit EntryReader(std::string_view data) : data_(data) {}
+
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+    T Read()
+    {
+        T value {};
+
+        if (data_.size() - pos_ < sizeof(T)) {
+            ok_ = false;
+            return value;
+        }
+
+        std::memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        auto size = Read<uint64_t>();
+
+        if (data_.size() - pos_ < size) {
+            ok_ = false;
+            return {};
+        }
+
+        std::string str(data_.substr(pos_, size));
+        pos_ += size;
+        return str;
+    }
+
+    // Guards the element count of a vector against damaged entries before anything is allocated for it
+    size_t ReadCount()
+    {
+        auto count = Read<uint64_t>();
+
+        if (count > data_.size() - pos_) {
+            ok_ = false;
+            return 0;
+        }
+
+        return count;
+    }
+
+    void Fail()
+    {
+        ok_ = false;
+    }
+
+    bool Ok() const
+    {
+        return ok_;
+    }
+
+    bool AtEnd() const
+    {
+        return pos_ == data_.size();
+    }
+
+private:
+    std::string_view data_;
+    size_t pos_ {0};
+    bool ok_ {true};
+};
+
+// The source node the code of the function is generated from, class fields are initialized by the constructor
+static const ir::AstNode *CodeNode(const binder::FunctionScope *scope)
+{
+    const ir::AstNode *node = scope->Node();
+
+    if (node->IsScriptFunction() && node->AsScriptFunction()->IsConstructor()) {
+        return util::Helpers::GetClassDefiniton(node->AsScriptFunction());
+    }
+
+    return node;
+}
+
+// Whether an identifier is in its temporal dead zone depends on declarations outside of the function, and the
+// names of nested functions depend on their index in the binder
+static void HashSubtree(const ir::AstNode *node, KeyHasher *hasher)
+{
+    node->Iterate([hasher](ir::AstNode *child) {
+        if (child->IsIdentifier()) {
+            hasher->Update(static_cast<uint8_t>(child->AsIdentifier()->IsTdz()));
+        } else if (child->IsScriptFunction()) {
+            const auto *scope = child->AsScriptFunction()->Scope();
+            hasher->Update(scope != nullptr ? scope->InternalName().Utf8() : std::string_view {});
+        }
+
+        HashSubtree(child, hasher);
+    });
+}
+
+static void WriteLiteral(EntryWriter *writer, const panda::pandasm::LiteralArray::Literal &literal)
+{
+    writer->Write(static_cast<uint8_t>(literal.tag_));
+    writer->Write(static_cast<uint8_t>(literal.value_.index()));
+
+    std::visit(
+        [writer](const auto &value) {
+            using T = std::decay_t<decltype(value)>;
+
+            if constexpr (std::is_same_v<T, std::string>) {
+                writer->Write(std::string_view {value});
+            } else {
+                writer->Write(value);
+            }
+        },
+        literal.value_);
+}
+
+static panda::pandasm::LiteralArray::Literal ReadLiteral(EntryReader *reader)
+{
+    panda::pandasm::LiteralArray::Literal literal;
+    literal.tag_ = static_cast<panda::panda_file::LiteralTag>(reader->Read<uint8_t>());
+
+    switch (reader->Read<uint8_t>()) {
+        case 0: {
+            literal.value_ = reader->Read<bool>();
+            break;
+        }
+        case 1: {
+            literal.value_ = reader->Read<uint8_t>();
+            break;
+        }
+        case 2: {
+            literal.value_ = reader->Read<uint16_t>();
+            break;
+        }
+        case 3: {
+            literal.value_ = reader->Read<uint32_t>();
+            break;
+        }
+        case 4: {
+            literal.value_ = reader->Read<uint64_t>();
+            break;
+        }
+        case 5: {
+            literal.value_ = reader->Read<float>();
+            break;
+        }
+        case 6: {
+            literal.value_ = reader->Read<double>();
+            break;
+        }
+        case 7: {
+            literal.value_ = reader->ReadString();
+            break;
+        }
+        default: {
+            reader->Fail();
+            break;
+        }
+    }
+
+    return literal;
+}
+
+static void WriteInstruction(EntryWriter *writer, const panda::pandasm::Ins &ins, size_t baseLine)
+{
+    writer->Write(static_cast<uint32_t>(ins.opcode));
+
+    writer->Write(static_cast<uint64_t>(ins.regs.size()));
+    for (auto reg : ins.regs) {
+        writer->Write(reg);
+    }
+
+    writer->Write(static_cast<uint64_t>(ins.ids.size()));
+    for (const auto &id : ins.ids) {
+        writer->Write(std::string_view {id});
+    }
+
+    writer->Write(static_cast<uint64_t>(ins.imms.size()));
+    for (const auto &imm : ins.imms) {
+        writer->Write(static_cast<uint8_t>(imm.index()));
+        std::visit([writer](auto value) { writer->Write(value); }, imm);
+    }
+
+    writer->Write(std::string_view {ins.label});
+    writer->Write(static_cast<uint8_t>(ins.set_label));
+
+    const auto &debug = ins.ins_debug;
+    writer->Write(static_cast<int64_t>(debug.line_number) - static_cast<int64_t>(baseLine));
+    writer->Write(std::string_view {debug.whole_line});
+    writer->Write(static_cast<uint64_t>(debug.bound_left));
+    writer->Write(static_cast<uint64_t>(debug.bound_right));
+}
+
+static void ReadInstruction(EntryReader *reader, panda::pandasm::Ins *ins, size_t baseLine)
+{
+    ins->opcode = static_cast<panda::pandasm::Opcode>(reader->Read<uint32_t>());
+
+    ins->regs.resize(reader->ReadCount());
+    for (auto &reg : ins->regs) {
+        reg = reader->Read<uint16_t>();
+    }
+
+    ins->ids.resize(reader->ReadCount());
+    for (auto &id : ins->ids) {
+        id = reader->ReadString();
+    }
+
+    ins->imms.resize(reader->ReadCount());
+    for (auto &imm : ins->imms) {
+        if (reader->Read<uint8_t>() == 0) {
+            imm = reader->Read<int64_t>();
+        } else {
+            imm = reader->Read<double>();
+        }
+    }
+
+    ins->label = reader->ReadString();
+    ins->set_label = reader->Read<uint8_t>() != 0;
+
+    auto &debug = ins->ins_debug;
+    debug.line_number = static_cast<size_t>(reader->Read<int64_t>() + static_cast<int64_t>(baseLine));
+    debug.whole_line = reader->ReadString();
+    debug.bound_left = reader->Read<uint64_t>();
+    debug.bound_right = reader->Read<uint64_t>();
+}
+
+FunctionCache::FunctionCache(std::string directory, const binder::Binder *binder, bool isDebug)
+    : directory_(std::move(directory)), binder_(binder), isDebug_(isDebug)
+{
+    for (const auto *function : binder_->Functions()) {
+        for (const binder::Scope *scope = function; scope != nullptr; scope = scope->Parent()) {
+            ComputeScopeDigests(scope);
+        }
+    }
+}
+
+void FunctionCache::ComputeScopeDigests(const binder::Scope *scope)
+{
+    if (scopeDigests_.find(scope) != scopeDigests_.end()) {
+        return;
+    }
+
+    KeyHasher hasher;
+    hasher.Update(scope->Type());
+
+    if (scope->IsVariableScope()) {
+        const auto *varScope = scope->AsVariableScope();
+
+        for (auto flag : {binder::VariableScopeFlags::SET_LEXICAL_FUNCTION, binder::VariableScopeFlags::USE_ARGS,
+                          binder::VariableScopeFlags::USE_SUPER, binder::VariableScopeFlags::INNER_ARROW}) {
+            hasher.Update(static_cast<uint8_t>(varScope->HasFlag(flag)));
+        }
+
+        hasher.Update(varScope->LexicalSlots());
+    }
+
+    /* Bindings are hashed in name order, the iteration order of the map is unspecified */
+    std::vector<std::pair<util::StringView, const binder::Variable *>> bindings(scope->Bindings().begin(),
+                                                                               scope->Bindings().end());
+    std::sort(bindings.begin(), bindings.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+    for (const auto &[name, variable] : bindings) {
+        /* Constants propagated from other modules are not part of the source text of the function */
+        if (variable->IsModuleVariable() && variable->AsModuleVariable()->PropagatedValue() != nullptr) {
+            scopeDigests_.emplace(scope, std::nullopt);
+            return;
+        }
+
+        hasher.Update(name.Utf8());
+        hasher.Update(variable->Type());
+        hasher.Update(variable->Flags());
+        hasher.Update(variable->Declaration() != nullptr ? static_cast<int32_t>(variable->Declaration()->Type()) : -1);
+
+        if (variable->IsLocalVariable() && variable->LexicalBound()) {
+            hasher.Update(variable->AsLocalVariable()->LexIdx());
+        }
+    }
+
+    scopeDigests_.emplace(scope, hasher.Digest());
+}
+
+std::optional<FunctionCache::Key> FunctionCache::ComputeKey(const binder::FunctionScope *scope) const
+{
+    KeyHasher hasher;
+    hasher.Update(BUILD_ID);
+    hasher.Update(static_cast<uint8_t>(isDebug_));
+
+    for (const binder::Scope *iter = scope; iter != nullptr; iter = iter->Parent()) {
+        auto res = scopeDigests_.find(iter);
+
+        if (res == scopeDigests_.end() || !res->second.has_value()) {
+            return std::nullopt;
+        }
+
+        hasher.Update(*res->second);
+    }
+
+    hasher.Update(scope->InternalName().Utf8());
+    hasher.Update(scope->Name().Utf8());
+
+    const ir::AstNode *node = CodeNode(scope);
+    const auto &range = node->Range();
+    auto source = binder_->Program()->SourceCode();
+    hasher.Update(node->IsProgram() ? source.Utf8() : source.Substr(range.start.index, range.end.index).Utf8());
+
+    HashSubtree(node, &hasher);
+
+    auto [hash, check] = hasher.Digest();
+    return Key {hash, check, node->IsProgram() ? 0 : range.start.line};
+}
+
+std::string FunctionCache::EntryPath(const Key &key) const
+{
+    std::stringstream ss;
+    ss << directory_ << '/' << std::hex << std::setw(16) << std::setfill('0') << key.hash << ".fc";
+    return ss.str();
+}
+
+std::unique_ptr<CachedFunction> FunctionCache::Load(const Key &key, const binder::FunctionScope *scope,
+                                                    CompilerContext *context) const
+{
+    std::ifstream inputStream(EntryPath(key), std::ios::binary);
+
+    if (inputStream.fail()) {
+        return nullptr;
+    }
+
+    std::stringstream ss;
+    ss << inputStream.rdbuf();
+    std::string data = ss.str();
+    EntryReader reader(data);
+
+    if (reader.Read<uint64_t>() != ENTRY_MAGIC || reader.Read<uint64_t>() != key.check) {
+        return nullptr;
+    }
+
+    auto cached = std::make_unique<CachedFunction>();
+    cached->function = std::make_unique<panda::pandasm::Function>(scope->InternalName().Mutf8(),
+                                                                  panda::pandasm::extensions::Language::ECMASCRIPT);
+    auto *func = cached->function.get();
+
+    auto paramCount = reader.ReadCount();
+    func->params.reserve(paramCount);
+
+    for (size_t i = 0; i < paramCount; i++) {
+        func->params.emplace_back(panda::pandasm::Type("any", 0),
+                                  panda::pandasm::extensions::Language::ECMASCRIPT);
+    }
+
+    func->regs_num = reader.Read<uint64_t>();
+    func->return_type = panda::pandasm::Type("any", 0);
+    auto icSize = reader.Read<uint32_t>();
+    auto parameterLength = reader.Read<uint32_t>();
+
+    cached->strings.resize(reader.ReadCount());
+    for (auto &str : cached->strings) {
+        str = reader.ReadString();
+    }
+
+    struct StoredBuffer {
+        int32_t index;
+        std::string key;
+        std::vector<panda::pandasm::LiteralArray::Literal> literals;
+    };
+
+    std::vector<StoredBuffer> buffers(reader.ReadCount());
+    for (auto &buffer : buffers) {
+        buffer.index = reader.Read<int32_t>();
+        buffer.key = reader.ReadString();
+        buffer.literals.resize(reader.ReadCount());
+
+        for (auto &literal : buffer.literals) {
+            literal = ReadLiteral(&reader);
+        }
+    }
+
+    func->ins.resize(reader.ReadCount());
+    for (auto &ins : func->ins) {
+        ReadInstruction(&reader, &ins, key.line);
+    }
+
+    func->catch_blocks.resize(reader.ReadCount());
+    for (auto &catchBlock : func->catch_blocks) {
+        catchBlock.try_begin_label = reader.ReadString();
+        catchBlock.try_end_label = reader.ReadString();
+        catchBlock.catch_begin_label = reader.ReadString();
+        catchBlock.catch_end_label = reader.ReadString();
+    }
+
+    func->local_variable_debug.resize(reader.ReadCount());
+    for (auto &variableDebug : func->local_variable_debug) {
+        variableDebug.name = reader.ReadString();
+        variableDebug.signature = reader.ReadString();
+        variableDebug.signature_type = reader.ReadString();
+        variableDebug.reg = reader.Read<int32_t>();
+        variableDebug.start = reader.Read<uint32_t>();
+        variableDebug.length = reader.Read<uint32_t>();
+    }
+
+    if (!reader.Ok() || !reader.AtEnd()) {
+        return nullptr;
+    }
+
+    /* Validate the literal buffer references before anything is interned, a partially restored entry would leave
+     * interned buffers behind which no function emits */
+    std::unordered_set<int32_t> storedIndices;
+    for (const auto &buffer : buffers) {
+        storedIndices.insert(buffer.index);
+    }
+
+    for (const auto &ins : func->ins) {
+        if (!Emitter::RefersToLiteralBuffer(ins)) {
+            continue;
+        }
+
+        if (ins.imms.empty() || !std::holds_alternative<int64_t>(ins.imms[0]) ||
+            storedIndices.count(static_cast<int32_t>(std::get<int64_t>(ins.imms[0]))) == 0) {
+            return nullptr;
+        }
+    }
+
+    /* Literal indices are allocated per compilation, the buffers get the indices of the current one */
+    std::unordered_map<int32_t, int32_t> indexMap;
+
+    for (auto &buffer : buffers) {
+        bool isNew = false;
+        int32_t index = context->InternLiteralBuffer(buffer.key, &isNew);
+        indexMap[buffer.index] = index;
+
+        if (isNew) {
+            cached->literalBuffers.emplace_back(index, std::move(buffer.literals));
+        }
+    }
+
+    for (auto &ins : func->ins) {
+        if (Emitter::RefersToLiteralBuffer(ins)) {
+            ins.imms[0] = static_cast<int64_t>(indexMap[static_cast<int32_t>(std::get<int64_t>(ins.imms[0]))]);
+        }
+    }
+
+    const auto *program = binder_->Program();
+    func->source_file = std::string {program->SourceFile()};
+
+    if (isDebug_ && scope->Node()->IsProgram()) {
+        func->source_code = program->SourceCode().EscapeSymbol<util::StringView::Mutf8Encode>();
+    }
+
+    FunctionEmitter::AddFunctionAnnotation(func, icSize, parameterLength, scope->Name().Mutf8());
+
+    return cached;
+}
+
+void FunctionCache::Store(const Key &key, const PandaGen *pg, FunctionEmitter *funcEmitter) const
+{
+    /* Recorded types are not part of the key */
+    if (!pg->InsnTypes().empty()) {
+        return;
+    }
+
+    const auto *func = funcEmitter->Function();
+    EntryWriter writer;
+
+    writer.Write(ENTRY_MAGIC);
+    writer.Write(key.check);
+    writer.Write(static_cast<uint64_t>(func->params.size()));
+    writer.Write(static_cast<uint64_t>(func->regs_num));
+    writer.Write(pg->IcSize());
+    writer.Write(pg->FormalParametersCount());
+
+    writer.Write(static_cast<uint64_t>(pg->Strings().size()));
+    for (const auto &str : pg->Strings()) {
+        writer.Write(std::string_view {str.Mutf8()});
+    }
+
+    /* Shared buffers are stored too, the function emits them if it is the first one to use them after a load */
+    writer.Write(static_cast<uint64_t>(pg->UsedBuffers().size()));
+    for (const auto *buff : pg->UsedBuffers()) {
+        writer.Write(buff->Index());
+        writer.Write(std::string_view {buff->Serialize()});
+
+        auto literals = FunctionEmitter::GenBufferLiterals(buff);
+        writer.Write(static_cast<uint64_t>(literals.size()));
+
+        for (const auto &literal : literals) {
+            WriteLiteral(&writer, literal);
+        }
+    }
+
+    writer.Write(static_cast<uint64_t>(func->ins.size()));
+    for (const auto &ins : func->ins) {
+        WriteInstruction(&writer, ins, key.line);
+    }
+
+    writer.Write(static_cast<uint64_t>(func->catch_blocks.size()));
+    for (const auto &catchBlock : func->catch_blocks) {
+        writer.Write(std::string_view {catchBlock.try_begin_label});
+        writer.Write(std::string_view {catchBlock.try_end_label});
+        writer.Write(std::string_view {catchBlock.catch_begin_label});
+        writer.Write(std::string_view {catchBlock.catch_end_label});
+    }
+
+    writer.Write(static_cast<uint64_t>(func->local_variable_debug.size()));
+    for (const auto &variableDebug : func->local_variable_debug) {
+        writer.Write(std::string_view {variableDebug.name});
+        writer.Write(std::string_view {variableDebug.signature});
+        writer.Write(std::string_view {variableDebug.signature_type});
+        writer.Write(variableDebug.reg);
+        writer.Write(variableDebug.start);
+        writer.Write(variableDebug.length);
+    }
+
+    /* Concurrent compilations may store the same entry, each one writes its own file and renames it in place */
+    std::string path = EntryPath(key);
+    std::string tmpPath = path + "." + std::to_string(std::random_device {}()) + ".tmp";
+
+    {
+        std::ofstream outputStream(tmpPath, std::ios::binary | std::ios::trunc);
+
+        if (outputStream.fail()) {
+            return;
+        }
+
+        outputStream.write(writer.Buffer().data(), static_cast<std::streamsize>(writer.Buffer().size()));
+
+        if (!outputStream.good()) {
+            outputStream.close();
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+    }
+}
+
+}  // namespace panda::es2panda::compiler
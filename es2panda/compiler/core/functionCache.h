@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES2PANDA_COMPILER_CORE_FUNCTION_CACHE_H
+#define ES2PANDA_COMPILER_CORE_FUNCTION_CACHE_H
+
+#include <assembly-literals.h>
+#include <macros.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace panda::pandasm {
+struct Function;
+}  // namespace panda::pandasm
+
+namespace panda::es2panda::binder {
+class Binder;
+class FunctionScope;
+class Scope;
+}  // namespace panda::es2panda::binder
+
+namespace panda::es2panda::compiler {
+
+class CompilerContext;
+class FunctionEmitter;
+class PandaGen;
+
+// A function restored from the cache, its literal buffers are interned in the current compilation
+struct CachedFunction {
+    std::unique_ptr<panda::pandasm::Function> function;
+    std::vector<std::string> strings;
+    // Literal buffers the function emits, the ones added by other functions first are not repeated
+    std::vector<std::pair<int32_t, std::vector<panda::pandasm::LiteralArray::Literal>>> literalBuffers;
+};
+
+// On-disk cache of the emitted functions of a program, one file per function.
+// An entry is keyed by everything the emitted function depends on: the source text and the TDZ marks of the
+// function, the internal names of the functions it defines, the binder layout of the scopes it is nested in and
+// the compiler options. Line numbers are stored relative to the function, so entries survive edits elsewhere.
+class FunctionCache {
+public:
+    struct Key {
+        uint64_t hash;
+        // Second hash of the key, compared on load to rule out collisions of the file names
+        uint64_t check;
+        // Line number of the function, line numbers of the instructions are stored relative to it
+        size_t line;
+    };
+
+    FunctionCache(std::string directory, const binder::Binder *binder, bool isDebug);
+    NO_COPY_SEMANTIC(FunctionCache);
+    NO_MOVE_SEMANTIC(FunctionCache);
+    ~FunctionCache() = default;
+
+    // Returns nothing if the emitted function may depend on information the key does not cover
+    std::optional<Key> ComputeKey(const binder::FunctionScope *scope) const;
+
+    // Returns nullptr on a miss or on a damaged entry, nothing is interned in the context in that case
+    std::unique_ptr<CachedFunction> Load(const Key &key, const binder::FunctionScope *scope,
+                                         CompilerContext *context) const;
+
+    // Writes the entry of the generated function, the function must not be added to the emitter yet
+    void Store(const Key &key, const PandaGen *pg, FunctionEmitter *funcEmitter) const;
+
+private:
+    using Digest = std::pair<uint64_t, uint64_t>;
+
+    void ComputeScopeDigests(const binder::Scope *scope);
+    std::string EntryPath(const Key &key) const;
+
+    std::string directory_;
+    const binder::Binder *binder_;
+    bool isDebug_;
+    // Digests of the bindings of every scope enclosing a function, nothing if the scope is not cacheable
+    std::unordered_map<const binder::Scope *, std::optional<Digest>> scopeDigests_;
+};
+
+}  // namespace panda::es2panda::compiler
+
+#endif
@@ -63,13 +63,19 @@ void CompileExports(PandaGen *pg, const binder::ModuleScope *scope)
         pg->StoreAccumulator(exportDecl, moduleReg);
 
         if (exportDecl->IsExportAllDeclaration()) {
-            pg->StoreModuleVar(exportDecl, decls.front()->ExportName());
+            if (!scope->IsRemovedExport(decls.front()->ExportName())) {
+                pg->StoreModuleVar(exportDecl, decls.front()->ExportName());
+            }
             continue;
         }
 
         pg->CopyModule(exportDecl, moduleReg);
 
         for (const auto *decl : decls) {
+            if (scope->IsRemovedExport(decl->ExportName())) {
+                continue;
+            }
+
             pg->LoadObjByName(decl->Node(), moduleReg, decl->LocalName());
             pg->StoreModuleVar(decl->Node(), decl->ExportName());
         }
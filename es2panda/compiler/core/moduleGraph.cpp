@@ -0,0 +1,611 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "moduleGraph.h"
+
+#include <binder/binder.h>
+#include <binder/scope.h>
+#include <binder/variable.h>
+#include <compiler/base/constantFolding.h>
+#include <ir/base/classDefinition.h>
+#include <ir/base/scriptFunction.h>
+#include <ir/expressions/identifier.h>
+#include <ir/expressions/importExpression.h>
+#include <ir/expressions/literals/stringLiteral.h>
+#include <ir/module/exportAllDeclaration.h>
+#include <ir/module/exportNamedDeclaration.h>
+#include <ir/module/importDeclaration.h>
+#include <ir/statements/blockStatement.h>
+#include <ir/statements/functionDeclaration.h>
+#include <ir/statements/variableDeclaration.h>
+#include <ir/statements/variableDeclarator.h>
+#include <parser/parserImpl.h>
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace panda::es2panda::compiler {
+
+using ReferenceCounts = std::unordered_map<const binder::Variable *, size_t>;
+using DeclarationCounts = std::unordered_map<util::StringView, size_t>;
+
+ModuleGraph::Module::Module(std::string name, std::unique_ptr<parser::ParserImpl> moduleParser,
+                            parser::Program &&moduleProgram)
+    : fileName(std::move(name)), parser(std::move(moduleParser)), program(std::move(moduleProgram))
+{
+}
+
+ModuleGraph::Module::~Module() = default;
+
+// Paths
+
+static bool IsRelativeSpecifier(std::string_view specifier)
+{
+    return specifier.rfind("./", 0) == 0 || specifier.rfind("../", 0) == 0;
+}
+
+static std::string DirName(const std::string &path)
+{
+    auto pos = path.find_last_of('/');
+    return pos == std::string::npos ? "." : path.substr(0, pos);
+}
+
+static bool HasExtension(const std::string &path)
+{
+    auto dot = path.find_last_of('.');
+    auto slash = path.find_last_of('/');
+    return dot != std::string::npos && (slash == std::string::npos || dot > slash);
+}
+
+// Resolves the "." and ".." segments lexically, so that every module has a single name
+static std::string NormalizePath(const std::string &path)
+{
+    std::vector<std::string> segments;
+    std::stringstream ss(path);
+    std::string segment;
+
+    while (std::getline(ss, segment, '/')) {
+        if (segment.empty() || segment == ".") {
+            continue;
+        }
+
+        if (segment == ".." && !segments.empty() && segments.back() != "..") {
+            segments.pop_back();
+            continue;
+        }
+
+        segments.push_back(segment);
+    }
+
+    std::string result = path.rfind('/', 0) == 0 ? "/" : "";
+
+    for (size_t i = 0; i < segments.size(); i++) {
+        result += (i == 0 ? "" : "/") + segments[i];
+    }
+
+    return result.empty() ? "." : result;
+}
+
+// AST helpers
+
+static bool IsDeclarationName(const ir::AstNode *parent, const ir::AstNode *ident)
+{
+    return (parent->IsVariableDeclarator() && parent->AsVariableDeclarator()->Id() == ident) ||
+           (parent->IsScriptFunction() && parent->AsScriptFunction()->Id() == ident) ||
+           (parent->IsClassDefinition() && parent->AsClassDefinition()->Ident() == ident);
+}
+
+static void CountReferences(const ir::AstNode *node, ReferenceCounts *counts, bool *hasEval)
+{
+    node->Iterate([node, counts, hasEval](ir::AstNode *child) {
+        /* Local names of export specifiers are tracked by the LOCAL_EXPORT flag of the variables */
+        if (child->IsExportSpecifier()) {
+            return;
+        }
+
+        if (child->IsIdentifier() && !IsDeclarationName(node, child)) {
+            const auto *ident = child->AsIdentifier();
+
+            if (ident->Variable() != nullptr) {
+                (*counts)[ident->Variable()]++;
+            } else if (ident->Name().Is("eval")) {
+                *hasEval = true;
+            }
+        }
+
+        CountReferences(child, counts, hasEval);
+    });
+}
+
+static void FindDynamicImports(const ir::AstNode *node, std::vector<const ir::ImportExpression *> *imports)
+{
+    node->Iterate([imports](ir::AstNode *child) {
+        if (child->IsImportExpression()) {
+            imports->push_back(child->AsImportExpression());
+        }
+
+        FindDynamicImports(child, imports);
+    });
+}
+
+static void RemoveFunctions(binder::Binder *binder, const ir::AstNode *node)
+{
+    node->Iterate([binder](ir::AstNode *child) {
+        if (child->IsScriptFunction()) {
+            binder->RemoveFunction(child->AsScriptFunction()->Scope());
+        }
+
+        RemoveFunctions(binder, child);
+    });
+}
+
+static void CountVarDeclarations(const ir::AstNode *node, DeclarationCounts *counts)
+{
+    node->Iterate([counts](ir::AstNode *child) {
+        if (child->IsVariableDeclaration() &&
+            child->AsVariableDeclaration()->Kind() == ir::VariableDeclaration::VariableDeclarationKind::VAR) {
+            for (const auto *declarator : child->AsVariableDeclaration()->Declarators()) {
+                if (declarator->Id()->IsIdentifier()) {
+                    (*counts)[declarator->Id()->AsIdentifier()->Name()]++;
+                }
+            }
+        }
+
+        /* Vars of nested functions are hoisted to their own scope */
+        if (!child->IsScriptFunction()) {
+            CountVarDeclarations(child, counts);
+        }
+    });
+}
+
+// The declaration wrapped by an export, or the statement itself
+static const ir::Statement *UnwrapExport(const ir::Statement *statement)
+{
+    if (statement->IsExportNamedDeclaration()) {
+        const auto *exportDecl = statement->AsExportNamedDeclaration();
+        return exportDecl->Decl() != nullptr && exportDecl->Specifiers().empty() ? exportDecl->Decl() : nullptr;
+    }
+
+    return statement;
+}
+
+static bool IsDeadBinding(binder::ModuleScope *scope, const util::StringView &name, const ReferenceCounts &counts)
+{
+    binder::Variable *variable = scope->FindLocal(name);
+    return variable != nullptr && !variable->HasFlag(binder::VariableFlags::LOCAL_EXPORT) &&
+           counts.find(variable) == counts.end();
+}
+
+// Evaluating the initializer of a removed declarator must not be observable
+static bool IsSideEffectFree(const ir::Expression *init)
+{
+    return init == nullptr || init->IsFunctionExpression() || init->IsArrowFunctionExpression() ||
+           ConstantFolding::IsConstant(init);
+}
+
+// Counts the declarations of each name which are hoisted to the module scope. Function declarations are only
+// hoisted from the top level, in a module they are lexical in blocks.
+static DeclarationCounts CountHoistedDeclarations(const ir::BlockStatement *ast)
+{
+    DeclarationCounts counts;
+    CountVarDeclarations(ast, &counts);
+
+    for (const auto *statement : ast->Statements()) {
+        const ir::Statement *decl = UnwrapExport(statement);
+
+        if (decl != nullptr && decl->IsFunctionDeclaration() &&
+            decl->AsFunctionDeclaration()->Function()->Id() != nullptr) {
+            counts[decl->AsFunctionDeclaration()->Function()->Id()->Name()]++;
+        }
+    }
+
+    return counts;
+}
+
+static bool IsDeadDeclaration(binder::ModuleScope *scope, const ir::Statement *statement,
+                              const ReferenceCounts &counts, const DeclarationCounts &declarations)
+{
+    const ir::Statement *decl = UnwrapExport(statement);
+
+    if (decl == nullptr) {
+        return false;
+    }
+
+    /* Hoisting defines a function redeclared by a var from the function declaration, so it has to stay */
+    if (decl->IsFunctionDeclaration()) {
+        const auto *func = decl->AsFunctionDeclaration()->Function();
+        return func->Id() != nullptr && declarations.at(func->Id()->Name()) == 1 &&
+               IsDeadBinding(scope, func->Id()->Name(), counts);
+    }
+
+    if (!decl->IsVariableDeclaration()) {
+        return false;
+    }
+
+    for (const auto *declarator : decl->AsVariableDeclaration()->Declarators()) {
+        if (!declarator->Id()->IsIdentifier() || !IsSideEffectFree(declarator->Init()) ||
+            !IsDeadBinding(scope, declarator->Id()->AsIdentifier()->Name(), counts)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void RemoveDeclaration(binder::Binder *binder, binder::ModuleScope *scope, const ir::Statement *statement,
+                              DeclarationCounts *declarations)
+{
+    const ir::Statement *decl = UnwrapExport(statement);
+    std::vector<util::StringView> names;
+
+    if (decl->IsFunctionDeclaration()) {
+        names.push_back(decl->AsFunctionDeclaration()->Function()->Id()->Name());
+    } else {
+        for (const auto *declarator : decl->AsVariableDeclaration()->Declarators()) {
+            names.push_back(declarator->Id()->AsIdentifier()->Name());
+        }
+    }
+
+    /* Hoisting would still define the removed functions and initialize the removed vars, but a var declared again
+     * by a remaining declaration has to be initialized for it */
+    for (const auto &name : names) {
+        auto found = declarations->find(name);
+
+        if (found != declarations->end() && --found->second != 0) {
+            continue;
+        }
+
+        scope->FindLocal(name)->RemoveFlag(binder::VariableFlags::HOIST);
+    }
+
+    RemoveFunctions(binder, statement);
+}
+
+static void CollectConstants(ModuleGraph::Module *module)
+{
+    for (const auto *statement : module->program.Ast()->Statements()) {
+        const ir::Statement *decl = UnwrapExport(statement);
+
+        if (decl == nullptr || !decl->IsVariableDeclaration() ||
+            decl->AsVariableDeclaration()->Kind() != ir::VariableDeclaration::VariableDeclarationKind::CONST) {
+            continue;
+        }
+
+        for (const auto *declarator : decl->AsVariableDeclaration()->Declarators()) {
+            if (declarator->Id()->IsIdentifier() && declarator->Init() != nullptr &&
+                ConstantFolding::IsConstant(declarator->Init())) {
+                module->constants.emplace(declarator->Id()->AsIdentifier()->Name(), declarator->Init());
+            }
+        }
+    }
+}
+
+static binder::ModuleScope *GetModuleScope(const ModuleGraph::Module *module)
+{
+    return module->program.Binder()->TopScope()->AsModuleScope();
+}
+
+// ModuleGraph
+
+void ModuleGraph::Load(const std::string &entryFile, const std::string &entrySource)
+{
+    AddModule(NormalizePath(entryFile), entrySource);
+
+    /* Loaded dependencies are appended, so they are resolved by the following iterations */
+    for (size_t i = 0; i < modules_.size(); i++) {
+        ResolveDependencies(modules_[i].get());
+    }
+}
+
+void ModuleGraph::AddModule(const std::string &fileName, const std::string &source)
+{
+    currentFile_ = fileName;
+
+    auto parser = std::make_unique<parser::ParserImpl>(extension_);
+    auto program = parser->ParseModule(fileName, source);
+
+    moduleIndices_.emplace(fileName, modules_.size());
+    modules_.push_back(std::make_unique<Module>(fileName, std::move(parser), std::move(program)));
+}
+
+void ModuleGraph::ResolveDependencies(Module *module)
+{
+    const auto *scope = GetModuleScope(module);
+
+    for (const auto &[importDecl, decls] : scope->Imports()) {
+        (void)decls;
+        AddDependency(module, importDecl->Source()->Str());
+    }
+
+    for (const auto &[exportDecl, decls] : scope->Exports()) {
+        (void)decls;
+        if (exportDecl->IsExportAllDeclaration()) {
+            AddDependency(module, exportDecl->AsExportAllDeclaration()->Source()->Str());
+        } else if (exportDecl->IsExportNamedDeclaration() && exportDecl->AsExportNamedDeclaration()->Source()) {
+            AddDependency(module, exportDecl->AsExportNamedDeclaration()->Source()->Str());
+        }
+    }
+
+    std::vector<const ir::ImportExpression *> dynamicImports;
+    FindDynamicImports(module->program.Ast(), &dynamicImports);
+
+    for (const auto *importExpr : dynamicImports) {
+        if (!importExpr->Source()->IsStringLiteral()) {
+            hasUnresolvedDynamicImport_ = true;
+            continue;
+        }
+
+        auto index = AddDependency(module, importExpr->Source()->AsStringLiteral()->Str());
+
+        if (index) {
+            module->dynamicImports.push_back(*index);
+        }
+    }
+}
+
+std::optional<size_t> ModuleGraph::AddDependency(Module *module, const util::StringView &specifier)
+{
+    auto iter = module->dependencies.find(specifier);
+    if (iter != module->dependencies.end()) {
+        return iter->second;
+    }
+
+    /* Bare specifiers name modules provided by the runtime, they are not part of the project */
+    std::string specifierStr(specifier.Utf8());
+    if (!IsRelativeSpecifier(specifierStr)) {
+        return std::nullopt;
+    }
+
+    std::string path = NormalizePath(DirName(module->fileName) + "/" + specifierStr);
+    std::vector<std::string> candidates;
+
+    if (HasExtension(path)) {
+        candidates.push_back(path);
+    } else {
+        std::string extension = extension_ == ScriptExtension::TS ? ".ts" : ".js";
+        candidates.push_back(path + extension);
+        candidates.push_back(path + "/index" + extension);
+    }
+
+    for (const auto &candidate : candidates) {
+        auto index = LoadModule(candidate);
+
+        if (index) {
+            module->dependencies.emplace(specifier, *index);
+            return index;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<size_t> ModuleGraph::LoadModule(const std::string &fileName)
+{
+    auto iter = moduleIndices_.find(fileName);
+    if (iter != moduleIndices_.end()) {
+        return iter->second;
+    }
+
+    std::ifstream inputStream(fileName);
+    if (inputStream.fail()) {
+        return std::nullopt;
+    }
+
+    std::stringstream ss;
+    ss << inputStream.rdbuf();
+
+    AddModule(fileName, ss.str());
+    return modules_.size() - 1;
+}
+
+void ModuleGraph::Optimize()
+{
+    for (auto &module : modules_) {
+        CollectConstants(module.get());
+    }
+
+    PropagateConstants(ComputeReachability());
+
+    if (!hasUnresolvedDynamicImport_) {
+        RemoveUnusedExports();
+    }
+
+    for (auto &module : modules_) {
+        RemoveDeadDeclarations(module.get());
+    }
+}
+
+// reachable[i][j] is true if evaluating module i requires module j, through at least one dependency
+std::vector<std::vector<bool>> ModuleGraph::ComputeReachability() const
+{
+    std::vector<std::vector<bool>> reachable(modules_.size(), std::vector<bool>(modules_.size(), false));
+
+    for (size_t i = 0; i < modules_.size(); i++) {
+        std::vector<size_t> worklist {i};
+
+        while (!worklist.empty()) {
+            size_t current = worklist.back();
+            worklist.pop_back();
+
+            for (const auto &[specifier, index] : modules_[current]->dependencies) {
+                (void)specifier;
+                if (!reachable[i][index]) {
+                    reachable[i][index] = true;
+                    worklist.push_back(index);
+                }
+            }
+        }
+    }
+
+    return reachable;
+}
+
+void ModuleGraph::PropagateConstants(const std::vector<std::vector<bool>> &reachable)
+{
+    for (size_t i = 0; i < modules_.size(); i++) {
+        auto *scope = GetModuleScope(modules_[i].get());
+
+        for (const auto &[importDecl, decls] : scope->Imports()) {
+            auto dependency = modules_[i]->dependencies.find(importDecl->Source()->Str());
+
+            /* Within a cycle the importer may read the binding before it is initialized */
+            if (dependency == modules_[i]->dependencies.end() || reachable[dependency->second][i]) {
+                continue;
+            }
+
+            const auto *exporter = modules_[dependency->second].get();
+            const auto &localExports = GetModuleScope(exporter)->LocalExports();
+
+            for (const auto *decl : decls) {
+                binder::Variable *variable = scope->FindLocal(decl->LocalName());
+
+                if (variable == nullptr || !variable->IsModuleVariable()) {
+                    continue;
+                }
+
+                for (const auto &[exported, exportName] : localExports) {
+                    if (exportName != decl->ImportName()) {
+                        continue;
+                    }
+
+                    auto constant = exporter->constants.find(exported->Name());
+
+                    if (constant != exporter->constants.end() && exported->Declaration()->IsConstDecl()) {
+                        variable->AsModuleVariable()->SetPropagatedValue(constant->second);
+                        propagatedImports_.insert(decl);
+                    }
+
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void ModuleGraph::RemoveUnusedExports()
+{
+    std::vector<std::set<util::StringView>> used(modules_.size());
+    std::vector<bool> usedAll(modules_.size(), false);
+
+    /* Exports of the entry module are the interface of the project */
+    usedAll[0] = true;
+
+    for (const auto &module : modules_) {
+        const auto *scope = GetModuleScope(module.get());
+
+        for (const auto &[importDecl, decls] : scope->Imports()) {
+            auto dependency = module->dependencies.find(importDecl->Source()->Str());
+            if (dependency == module->dependencies.end()) {
+                continue;
+            }
+
+            for (const auto *decl : decls) {
+                if (decl->ImportName().Is("*")) {
+                    usedAll[dependency->second] = true;
+                } else if (propagatedImports_.find(decl) == propagatedImports_.end()) {
+                    used[dependency->second].insert(decl->ImportName());
+                }
+            }
+        }
+
+        for (const auto &[exportDecl, decls] : scope->Exports()) {
+            if (exportDecl->IsExportAllDeclaration()) {
+                auto dependency = module->dependencies.find(exportDecl->AsExportAllDeclaration()->Source()->Str());
+                if (dependency != module->dependencies.end()) {
+                    usedAll[dependency->second] = true;
+                }
+                continue;
+            }
+
+            if (!exportDecl->IsExportNamedDeclaration() || !exportDecl->AsExportNamedDeclaration()->Source()) {
+                continue;
+            }
+
+            auto dependency = module->dependencies.find(exportDecl->AsExportNamedDeclaration()->Source()->Str());
+            if (dependency == module->dependencies.end()) {
+                continue;
+            }
+
+            /* Re-exported bindings are conservatively kept alive */
+            for (const auto *decl : decls) {
+                used[dependency->second].insert(decl->LocalName());
+            }
+        }
+
+        for (size_t index : module->dynamicImports) {
+            usedAll[index] = true;
+        }
+    }
+
+    for (size_t i = 0; i < modules_.size(); i++) {
+        if (usedAll[i]) {
+            continue;
+        }
+
+        auto *scope = GetModuleScope(modules_[i].get());
+        std::vector<util::StringView> unused;
+
+        for (const auto &[exportDecl, decls] : scope->Exports()) {
+            (void)exportDecl;
+            for (const auto *decl : decls) {
+                if (!decl->ExportName().Is("*") && used[i].find(decl->ExportName()) == used[i].end()) {
+                    unused.push_back(decl->ExportName());
+                }
+            }
+        }
+
+        for (const auto &name : unused) {
+            scope->RemoveExport(name);
+        }
+    }
+}
+
+void ModuleGraph::RemoveDeadDeclarations(Module *module)
+{
+    auto *binder = module->program.Binder();
+    auto *scope = GetModuleScope(module);
+    auto &statements = module->program.Ast()->Statements();
+    bool changed = true;
+
+    /* Removing a declaration may leave the declarations only it referred to unused */
+    while (changed) {
+        changed = false;
+
+        ReferenceCounts counts;
+        bool hasEval = false;
+        CountReferences(module->program.Ast(), &counts, &hasEval);
+
+        /* Direct eval may refer to any binding */
+        if (hasEval) {
+            return;
+        }
+
+        DeclarationCounts declarations = CountHoistedDeclarations(module->program.Ast());
+
+        for (auto iter = statements.begin(); iter != statements.end();) {
+            if (!IsDeadDeclaration(scope, *iter, counts, declarations)) {
+                ++iter;
+                continue;
+            }
+
+            RemoveDeclaration(binder, scope, *iter, &declarations);
+            iter = statements.erase(iter);
+            changed = true;
+        }
+    }
+}
+
+}  // namespace panda::es2panda::compiler
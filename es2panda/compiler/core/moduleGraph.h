@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES2PANDA_COMPILER_CORE_MODULE_GRAPH_H
+#define ES2PANDA_COMPILER_CORE_MODULE_GRAPH_H
+
+#include <es2panda.h>
+#include <macros.h>
+#include <parser/program/program.h>
+#include <util/ustring.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace panda::es2panda::parser {
+class ParserImpl;
+}  // namespace panda::es2panda::parser
+
+namespace panda::es2panda::binder {
+class ImportDecl;
+}  // namespace panda::es2panda::binder
+
+namespace panda::es2panda::ir {
+class Expression;
+}  // namespace panda::es2panda::ir
+
+namespace panda::es2panda::compiler {
+
+// The modules reachable from an entry module through relative import and export specifiers.
+// Knowing every importer of a module allows optimizations across module boundaries.
+class ModuleGraph {
+public:
+    struct Module {
+        Module(std::string name, std::unique_ptr<parser::ParserImpl> moduleParser, parser::Program &&moduleProgram);
+        NO_COPY_SEMANTIC(Module);
+        NO_MOVE_SEMANTIC(Module);
+        ~Module();
+
+        std::string fileName;
+        // The binder refers to the program of the parser, which must outlive the moved program
+        std::unique_ptr<parser::ParserImpl> parser;
+        parser::Program program;
+        // Module indices of the resolved import, export and import() specifiers
+        std::unordered_map<util::StringView, size_t> dependencies;
+        std::vector<size_t> dynamicImports;
+        // Top level const bindings initialized with a constant expression
+        std::unordered_map<util::StringView, const ir::Expression *> constants;
+    };
+
+    explicit ModuleGraph(ScriptExtension extension) : extension_(extension) {}
+    NO_COPY_SEMANTIC(ModuleGraph);
+    NO_MOVE_SEMANTIC(ModuleGraph);
+    ~ModuleGraph() = default;
+
+    // Parses the entry module and every module it reaches, parse errors are thrown
+    void Load(const std::string &entryFile, const std::string &entrySource);
+
+    // Inlines constant imports, then removes exports which no module imports and dead top level declarations
+    void Optimize();
+
+    // The entry module comes first
+    const std::vector<std::unique_ptr<Module>> &Modules() const
+    {
+        return modules_;
+    }
+
+    // Module being parsed when Load threw
+    const std::string &CurrentFile() const
+    {
+        return currentFile_;
+    }
+
+private:
+    void AddModule(const std::string &fileName, const std::string &source);
+    void ResolveDependencies(Module *module);
+    std::optional<size_t> AddDependency(Module *module, const util::StringView &specifier);
+    std::optional<size_t> LoadModule(const std::string &fileName);
+    std::vector<std::vector<bool>> ComputeReachability() const;
+    void PropagateConstants(const std::vector<std::vector<bool>> &reachable);
+    void RemoveUnusedExports();
+    void RemoveDeadDeclarations(Module *module);
+
+    ScriptExtension extension_;
+    std::vector<std::unique_ptr<Module>> modules_;
+    std::unordered_map<std::string, size_t> moduleIndices_;
+    std::unordered_set<const binder::ImportDecl *> propagatedImports_;
+    std::string currentFile_;
+    // An import() with a computed specifier may load any module with any export
+    bool hasUnresolvedDynamicImport_ {false};
+};
+
+}  // namespace panda::es2panda::compiler
+
+#endif
@@ -20,6 +20,7 @@
 #include <binder/scope.h>
 #include <binder/variable.h>
 #include <compiler/base/catchTable.h>
+#include <compiler/base/constantFolding.h>
 #include <compiler/base/lexenv.h>
 #include <compiler/base/literals.h>
 #include <compiler/core/compilerContext.h>
@@ -37,6 +38,10 @@
 #include <ir/expressions/identifier.h>
 #include <ir/expressions/literals/numberLiteral.h>
 #include <ir/expressions/literals/stringLiteral.h>
+#include <ir/ts/tsEnumDeclaration.h>
+#include <typescript/types/type.h>
+
+#include <optional>
 
 namespace panda::es2panda::compiler {
 
@@ -48,6 +53,69 @@ Label *PandaGen::AllocLabel()
     return sa_.AllocLabel(std::move(id));
 }
 
+// Type indices of the builtin types, in the order of the primitive types of ts2panda
+enum class BuiltinTypeIndex : int32_t {
+    ANY,
+    NUMBER,
+    BOOLEAN,
+    VOID,
+    STRING,
+    SYMBOL,
+    NULL_TYPE,
+    UNDEFINED,
+};
+
+static std::optional<BuiltinTypeIndex> GetBuiltinTypeIndex(const checker::Type *type)
+{
+    if (type->HasTypeFlag(checker::TypeFlag::ANY)) {
+        return BuiltinTypeIndex::ANY;
+    }
+
+    if (type->HasTypeFlag(checker::TypeFlag::NUMBER_LIKE)) {
+        return BuiltinTypeIndex::NUMBER;
+    }
+
+    if (type->HasTypeFlag(checker::TypeFlag::BOOLEAN_LIKE)) {
+        return BuiltinTypeIndex::BOOLEAN;
+    }
+
+    if (type->HasTypeFlag(checker::TypeFlag::VOID)) {
+        return BuiltinTypeIndex::VOID;
+    }
+
+    if (type->HasTypeFlag(checker::TypeFlag::STRING_LIKE)) {
+        return BuiltinTypeIndex::STRING;
+    }
+
+    if (type->HasTypeFlag(checker::TypeFlag::SYMBOL | checker::TypeFlag::UNIQUE_SYMBOL)) {
+        return BuiltinTypeIndex::SYMBOL;
+    }
+
+    if (type->HasTypeFlag(checker::TypeFlag::NULL_TYPE)) {
+        return BuiltinTypeIndex::NULL_TYPE;
+    }
+
+    if (type->HasTypeFlag(checker::TypeFlag::UNDEFINED)) {
+        return BuiltinTypeIndex::UNDEFINED;
+    }
+
+    /* Objects, unions and other composite types need type literal buffers, which are not emitted */
+    return std::nullopt;
+}
+
+void PandaGen::RecordVariableType(const IRNode *ins, const binder::Variable *variable)
+{
+    if (!context_->RecordType() || !variable->TsType()) {
+        return;
+    }
+
+    auto typeIndex = GetBuiltinTypeIndex(variable->TsType());
+
+    if (typeIndex) {
+        insnTypes_.insert({ins, static_cast<int32_t>(*typeIndex)});
+    }
+}
+
 bool PandaGen::IsDebug() const
 {
     return context_->IsDebug();
@@ -175,10 +243,18 @@ LiteralBuffer *PandaGen::NewLiteralBuffer()
     return allocator_->New<LiteralBuffer>(allocator_);
 }
 
-int32_t PandaGen::AddLiteralBuffer(LiteralBuffer *buf)
+int32_t PandaGen::AddLiteralBuffer(LiteralBuffer *buf, LiteralBufferKind kind)
 {
-    buffStorage_.push_back(buf);
-    buf->SetIndex(context_->NewLiteralIndex());
+    bool isNew = false;
+    buf->SetKind(kind);
+    buf->SetIndex(context_->InternLiteralBuffer(buf, &isNew));
+    usedBuffers_.push_back(buf);
+
+    // Identical buffers share one literal array, which is emitted by the function that added it first
+    if (isNew) {
+        buffStorage_.push_back(buf);
+    }
+
     return buf->Index();
 }
 
@@ -217,14 +293,49 @@ void PandaGen::LoadVar(const ir::Identifier *node, const binder::ScopeFindResult
     }
 
     if (var->IsModuleVariable()) {
+        const auto *value = var->AsModuleVariable()->PropagatedValue();
+
+        if (value != nullptr) {
+            ConstantFolding::CompileConstant(this, node, value);
+            return;
+        }
+
         LoadModuleVariable(node, var->AsModuleVariable()->ModuleReg(), var->AsModuleVariable()->ExoticName());
         return;
     }
 
+    if (var->IsEnumVariable()) {
+        LoadEnumMember(node, result);
+        return;
+    }
+
     ASSERT(var->IsLocalVariable());
     LoadAccFromLexEnv(node, result);
 }
 
+void PandaGen::LoadEnumMember(const ir::Identifier *node, const binder::ScopeFindResult &result)
+{
+    // Members referenced in the initializers of an enum are read from the enum object
+    const auto *enumDecl = result.scope->Node()->AsTSEnumDeclaration();
+    const util::StringView &enumName = enumDecl->Key()->Name();
+    binder::ScopeFindResult objResult = scope_->Find(enumName);
+
+    if (objResult.scope == result.scope) {
+        /* A member shadows the enum object, look it up right outside of the enum */
+        binder::ScopeFindResult outerResult = result.scope->Parent()->Find(enumName);
+        outerResult.level += objResult.level;
+        outerResult.lexLevel += objResult.lexLevel;
+        objResult = outerResult;
+    }
+
+    RegScope rs(this);
+    VReg obj = AllocReg();
+
+    LoadVar(enumDecl->Key(), objResult);
+    StoreAccumulator(node, obj);
+    LoadObjByName(node, obj, result.variable->Name());
+}
+
 void PandaGen::StoreVar(const ir::AstNode *node, const binder::ScopeFindResult &result, bool isDeclaration)
 {
     binder::Variable *var = result.variable;
@@ -248,9 +359,9 @@ void PandaGen::StoreVar(const ir::AstNode *node, const binder::ScopeFindResult &
     StoreAccToLexEnv(node, result, isDeclaration);
 }
 
-void PandaGen::StoreAccumulator(const ir::AstNode *node, VReg vreg)
+IRNode *PandaGen::StoreAccumulator(const ir::AstNode *node, VReg vreg)
 {
-    ra_.Emit<StaDyn>(node, vreg);
+    return ra_.Emit<StaDyn>(node, vreg);
 }
 
 void PandaGen::LoadAccFromArgs(const ir::AstNode *node)
@@ -1140,6 +1251,12 @@ void PandaGen::CreateArrayWithBuffer(const ir::AstNode *node, uint32_t idx)
     sa_.Emit<EcmaCreatearraywithbuffer>(node, idx);
 }
 
+void PandaGen::CreateRegExpWithLiteral(const ir::AstNode *node, const util::StringView &pattern, uint8_t flags)
+{
+    sa_.Emit<EcmaCreateregexpwithliteral>(node, pattern, flags);
+    strings_.insert(pattern);
+}
+
 void PandaGen::CreateArray(const ir::AstNode *node, const ArenaVector<ir::Expression *> &elements, VReg obj)
 {
     if (elements.empty()) {
@@ -1153,15 +1270,20 @@ void PandaGen::CreateArray(const ir::AstNode *node, const ArenaVector<ir::Expres
     size_t i = 0;
     // This loop handles constant literal data by collecting it into a literal buffer
     // until a non-constant element is encountered.
-    while (i < elements.size() && util::Helpers::IsConstantExpr(elements[i])) {
-        buf->Add(elements[i]->AsLiteral());
+    while (i < elements.size()) {
+        const auto *constant = ConstantFolding::TryFoldLiteral(this, elements[i]);
+        if (constant == nullptr) {
+            break;
+        }
+
+        buf->Add(constant);
         i++;
     }
 
     if (buf->IsEmpty()) {
         CreateEmptyArray(node);
     } else {
-        uint32_t bufIdx = AddLiteralBuffer(buf);
+        uint32_t bufIdx = AddLiteralBuffer(buf, LiteralBufferKind::ARRAY);
         CreateArrayWithBuffer(node, bufIdx);
     }
 
@@ -30,6 +30,7 @@ namespace panda::es2panda::binder {
 class FunctionScope;
 class ScopeFindResult;
 class Scope;
+class Variable;
 }  // namespace panda::es2panda::binder
 
 namespace panda::es2panda::ir {
@@ -45,6 +46,7 @@ namespace panda::es2panda::compiler {
 class FunctionBuilder;
 class CompilerContext;
 class LiteralBuffer;
+enum class LiteralBufferKind : uint8_t;
 class DynamicContext;
 class CatchTable;
 
@@ -85,6 +87,8 @@ public:
           catchList_(allocator_->Adapter()),
           strings_(allocator_->Adapter()),
           buffStorage_(allocator_->Adapter()),
+          usedBuffers_(allocator_->Adapter()),
+          insnTypes_(allocator_->Adapter()),
           sa_(this),
           ra_(this),
           rra_(this)
@@ -174,11 +178,22 @@ public:
         return buffStorage_;
     }
 
+    // Every literal buffer the function refers to, including the ones emitted by other functions
+    const ArenaVector<const compiler::LiteralBuffer *> &UsedBuffers() const
+    {
+        return usedBuffers_;
+    }
+
     uint32_t IcSize() const
     {
         return ic_.Size();
     }
 
+    const ArenaUnorderedMap<const IRNode *, int32_t> &InsnTypes() const
+    {
+        return insnTypes_;
+    }
+
     bool IsDebug() const;
     uint32_t ParamCount() const;
     uint32_t FormalParametersCount() const;
@@ -196,8 +211,11 @@ public:
     void FunctionEnter();
     void FunctionExit();
 
+    // Annotates the instruction storing the declared variable with the checked type of the variable
+    void RecordVariableType(const IRNode *ins, const binder::Variable *variable);
+
     LiteralBuffer *NewLiteralBuffer();
-    int32_t AddLiteralBuffer(LiteralBuffer *buf);
+    int32_t AddLiteralBuffer(LiteralBuffer *buf, LiteralBufferKind kind);
 
     void InitializeLexEnv(const ir::AstNode *node, VReg lexEnv);
     void CopyFunctionArguments(const ir::AstNode *node);
@@ -208,7 +226,7 @@ public:
     void LoadVar(const ir::Identifier *node, const binder::ScopeFindResult &result);
     void StoreVar(const ir::AstNode *node, const binder::ScopeFindResult &result, bool isDeclaration);
 
-    void StoreAccumulator(const ir::AstNode *node, VReg vreg);
+    IRNode *StoreAccumulator(const ir::AstNode *node, VReg vreg);
     void LoadAccFromArgs(const ir::AstNode *node);
     void LoadObjProperty(const ir::AstNode *node, VReg obj, const Operand &prop);
 
@@ -319,6 +337,7 @@ public:
     void CreateEmptyArray(const ir::AstNode *node);
     void CreateArray(const ir::AstNode *node, const ArenaVector<ir::Expression *> &elements, VReg obj);
     void CreateArrayWithBuffer(const ir::AstNode *node, uint32_t idx);
+    void CreateRegExpWithLiteral(const ir::AstNode *node, const util::StringView &pattern, uint8_t flags);
     void StoreArraySpread(const ir::AstNode *node, VReg array, VReg index);
 
     void ThrowIfNotObject(const ir::AstNode *node);
@@ -385,6 +404,8 @@ public:
     }
 
 private:
+    void LoadEnumMember(const ir::Identifier *node, const binder::ScopeFindResult &result);
+
     ArenaAllocator *allocator_;
     CompilerContext *context_;
     FunctionBuilder *builder_;
@@ -396,6 +417,8 @@ private:
     ArenaVector<CatchTable *> catchList_;
     ArenaSet<util::StringView> strings_;
     ArenaVector<LiteralBuffer *> buffStorage_;
+    ArenaVector<const LiteralBuffer *> usedBuffers_;
+    ArenaUnorderedMap<const IRNode *, int32_t> insnTypes_;
     EnvScope *envScope_ {};
     DynamicContext *dynamicContext_ {};
     InlineCache ic_;
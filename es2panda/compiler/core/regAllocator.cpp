@@ -23,8 +23,36 @@ namespace panda::es2panda::compiler {
 
 // RegAllocatorBase
 
+static const Format *MatchFormat(const IRNode *ins)
+{
+    std::array<const VReg *, IRNode::MAX_REG_OPERAND> regs {};
+    auto regCnt = ins->Registers(&regs);
+    auto registers = Span<const VReg *>(regs.data(), regs.data() + regCnt);
+
+    for (const auto &format : ins->GetFormats()) {
+        size_t limit = 0;
+        for (const auto &formatItem : format.GetFormatItem()) {
+            if (formatItem.IsVReg()) {
+                limit = 1 << formatItem.Bitwidth();
+                break;
+            }
+        }
+
+        if (std::all_of(registers.begin(), registers.end(), [limit](const VReg *reg) { return *reg < limit; })) {
+            return &format;
+        }
+    }
+
+    return nullptr;
+}
+
 void AllocatorBase::PushBack(IRNode *ins)
 {
+    if (ins->GetFormat() == nullptr) {
+        ins->SetFormat(MatchFormat(ins));
+    }
+
+    ASSERT(ins->GetFormat() != nullptr || ins->GetFormats().empty());
     pg_->Insns().push_back(ins);
 }
 
@@ -107,6 +107,7 @@ protected:
 
             if (std::all_of(registers.begin(), registers.end(),
                             [this](const VReg *reg) { return IsRegisterCorrect(reg); })) {
+                ins->SetFormat(&format);
                 return true;
             }
         }
@@ -134,10 +135,11 @@ public:
     ~RegAllocator() = default;
 
     template <typename T, typename... Args>
-    void Emit(const ir::AstNode *node, Args &&... args)
+    T *Emit(const ir::AstNode *node, Args &&... args)
     {
         auto *ins = Alloc<T>(node, std::forward<Args>(args)...);
         Run(ins);
+        return ins;
     }
 
 private:
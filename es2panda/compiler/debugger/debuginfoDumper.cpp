@@ -17,12 +17,11 @@
 
 #include <macros.h>
 
-#include <sstream>
 #include <string>
 
 namespace panda::es2panda::debuginfo {
 
-DebugInfoDumper::DebugInfoDumper(const pandasm::Program *prog) : prog_(prog) {}
+DebugInfoDumper::DebugInfoDumper(const pandasm::Program *prog, std::ostream &out) : prog_(prog), out_(out) {}
 
 static const char *PutComma(bool comma)
 {
@@ -32,17 +31,17 @@ static const char *PutComma(bool comma)
 template <typename T>
 void DebugInfoDumper::WrapArray(const char *name, const std::vector<T> &array, bool comma)
 {
-    ss_ << std::endl;
+    out_ << '\n';
     Indent();
-    ss_ << "\"" << name << "\": "
+    out_ << "\"" << name << "\": "
         << "[";
 
     if (array.empty()) {
-        ss_ << "]" << PutComma(comma);
+        out_ << "]" << PutComma(comma);
         return;
     }
 
-    ss_ << "\n";
+    out_ << "\n";
     indent_++;
     // dump VariableDebugInfo in reverse order to match ts2panda
     // NOLINTNEXTLINE
@@ -51,8 +50,8 @@ void DebugInfoDumper::WrapArray(const char *name, const std::vector<T> &array, b
         for (elem = array.rbegin(); elem != array.rend(); ++elem) {
             Indent();
             WriteVariableInfo(*elem);
-            (std::next(elem) == array.rend()) ? ss_ << "" : ss_ << ",";
-            ss_ << "\n";
+            (std::next(elem) == array.rend()) ? out_ << "" : out_ << ",";
+            out_ << "\n";
         }
         // NOLINTNEXTLINE
     } else {
@@ -64,36 +63,36 @@ void DebugInfoDumper::WrapArray(const char *name, const std::vector<T> &array, b
                 WriteIns(*elem);
                 // NOLINTNEXTLINE
             } else if constexpr (std::is_same_v<T, pandasm::Function::Parameter>) {
-                ss_ << "\"" << (*elem).type.GetName() << "\"";
+                out_ << "\"" << (*elem).type.GetName() << "\"";
                 // NOLINTNEXTLINE
             } else if constexpr (std::is_same_v<T, std::string>) {
-                ss_ << "\"" << *elem << "\"";
+                out_ << "\"" << *elem << "\"";
                 // NOLINTNEXTLINE
             } else if constexpr (std::is_same_v<T, std::variant<int64_t, double>>) {
                 if (std::holds_alternative<int64_t>(*elem)) {
-                    ss_ << std::to_string(std::get<int64_t>(*elem));
+                    out_ << std::to_string(std::get<int64_t>(*elem));
                 } else {
-                    ss_ << std::to_string(std::get<double>(*elem));
+                    out_ << std::to_string(std::get<double>(*elem));
                 }
                 // NOLINTNEXTLINE
             } else {
-                ss_ << std::to_string(*elem);
+                out_ << std::to_string(*elem);
             }
 
-            (std::next(elem) == array.end()) ? ss_ << "" : ss_ << ",";
-            ss_ << "\n";
+            (std::next(elem) == array.end()) ? out_ << "" : out_ << ",";
+            out_ << "\n";
         }
     }
 
     indent_--;
     Indent();
 
-    ss_ << "]" << PutComma(comma);
+    out_ << "]" << PutComma(comma);
 }
 
 void DebugInfoDumper::WriteIns(const pandasm::Ins &ins)
 {
-    ss_ << "{";
+    out_ << "{";
     {
         pandasm::Ins insCopy;
         insCopy.opcode = ins.opcode;
@@ -105,14 +104,14 @@ void DebugInfoDumper::WriteIns(const pandasm::Ins &ins)
     WrapArray("regs", ins.regs);
     WrapArray("ids", ins.ids);
     WrapArray("imms", ins.imms);
-    ss_ << std::endl;
+    out_ << '\n';
     Indent();
-    ss_ << "\"label\": "
+    out_ << "\"label\": "
         << "\"" << ins.label << "\",";
     WritePosInfo(ins.ins_debug);
     indent_--;
     Indent();
-    ss_ << "}";
+    out_ << "}";
 }
 
 void DebugInfoDumper::WriteMetaData(const std::vector<pandasm::AnnotationData> &metaData)
@@ -131,20 +130,20 @@ void DebugInfoDumper::WriteMetaData(const std::vector<pandasm::AnnotationData> &
 
 void DebugInfoDumper::WritePosInfo(const pandasm::debuginfo::Ins &posInfo)
 {
-    ss_ << std::endl;
+    out_ << '\n';
     Indent();
-    ss_ << "\"debug_pos_info\": {";
+    out_ << "\"debug_pos_info\": {";
     WriteProperty("boundLeft", posInfo.bound_left);
     WriteProperty("boundRight", posInfo.bound_right);
     WriteProperty("sourecLineNum", static_cast<int32_t>(posInfo.line_number));
     WriteProperty("wholeLine", posInfo.whole_line, false);
     Indent();
-    ss_ << "}" << std::endl;
+    out_ << "}" << '\n';
 }
 
 void DebugInfoDumper::WriteVariableInfo(const pandasm::debuginfo::LocalVariable &localVariableDebug)
 {
-    ss_ << "{";
+    out_ << "{";
     WriteProperty("name", localVariableDebug.name);
     WriteProperty("signature", localVariableDebug.signature);
     WriteProperty("signatureType", localVariableDebug.signature_type);
@@ -152,35 +151,35 @@ void DebugInfoDumper::WriteVariableInfo(const pandasm::debuginfo::LocalVariable
     WriteProperty("start", static_cast<size_t>(localVariableDebug.start));
     WriteProperty("length", static_cast<size_t>(localVariableDebug.length), false);
     Indent();
-    ss_ << "}";
+    out_ << "}";
 }
 
 void DebugInfoDumper::Dump()
 {
-    ss_ << "{\n";
+    out_ << "{\n";
     indent_++;
     Indent();
-    ss_ << "\"functions\": [" << std::endl;
+    out_ << "\"functions\": [" << '\n';
 
     auto iter = prog_->function_table.begin();
 
     for (; iter != prog_->function_table.end(); ++iter) {
         indent_++;
         Indent();
-        ss_ << "{";
+        out_ << "{";
         WriteProperty("name", iter->first);
-        ss_ << std::endl;
+        out_ << '\n';
 
         indent_++;
         Indent();
-        ss_ << "\"signature\": {";
+        out_ << "\"signature\": {";
         WriteProperty("retType", iter->second.return_type.GetName());
         indent_++;
         WrapArray("params", iter->second.params, false);
         indent_ -= 2U;
-        ss_ << std::endl;
+        out_ << '\n';
         Indent();
-        ss_ << "},";
+        out_ << "},";
 
         WrapArray("ins", iter->second.ins);
         WrapArray("variables", iter->second.local_variable_debug);
@@ -191,45 +190,44 @@ void DebugInfoDumper::Dump()
 
         indent_--;
         Indent();
-        ss_ << "}";
+        out_ << "}";
 
         if (std::next(iter) != prog_->function_table.end()) {
-            ss_ << ",";
+            out_ << ",";
         }
 
-        ss_ << std::endl;
+        out_ << '\n';
     }
 
     indent_--;
     Indent();
-    ss_ << "]" << std::endl;
-    ss_ << "}";
-    ss_ << std::endl;
-    std::cout << ss_.str();
+    out_ << "]" << '\n';
+    out_ << "}";
+    out_ << '\n';
 }
 
 void DebugInfoDumper::WriteProperty(const char *key, const Value &value, bool comma)
 {
-    ss_ << std::endl;
+    out_ << '\n';
     indent_++;
     Indent();
-    ss_ << "\"" << key << "\": ";
+    out_ << "\"" << key << "\": ";
     if (std::holds_alternative<std::string>(value)) {
-        ss_ << "\"" << std::get<std::string>(value) << "\"";
+        out_ << "\"" << std::get<std::string>(value) << "\"";
     } else if (std::holds_alternative<size_t>(value)) {
-        ss_ << std::to_string(std::get<size_t>(value));
+        out_ << std::to_string(std::get<size_t>(value));
     } else if (std::holds_alternative<int32_t>(value)) {
-        ss_ << std::to_string(std::get<int32_t>(value));
+        out_ << std::to_string(std::get<int32_t>(value));
     }
 
-    comma ? ss_ << "," : ss_ << std::endl;
+    comma ? out_ << "," : out_ << '\n';
     indent_--;
 }
 
 void DebugInfoDumper::Indent()
 {
     for (int32_t i = 0; i <= indent_; i++) {
-        ss_ << "  ";
+        out_ << "  ";
     }
 }
 
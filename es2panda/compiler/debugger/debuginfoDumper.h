@@ -20,13 +20,16 @@
 #include <assembly-program.h>
 #include <macros.h>
 
+#include <iostream>
+
 namespace panda::es2panda::debuginfo {
 
 using Value = std::variant<std::string, size_t, int32_t>;
 
 class DebugInfoDumper {
 public:
-    explicit DebugInfoDumper(const pandasm::Program *prog);
+    // The functions are written to out one by one, nothing but the current instruction is buffered
+    explicit DebugInfoDumper(const pandasm::Program *prog, std::ostream &out = std::cout);
     ~DebugInfoDumper() = default;
     NO_COPY_SEMANTIC(DebugInfoDumper);
     NO_MOVE_SEMANTIC(DebugInfoDumper);
@@ -44,7 +47,7 @@ private:
     void Indent();
 
     const pandasm::Program *prog_;
-    std::stringstream ss_;
+    std::ostream &out_;
     int32_t indent_ {0};
 };
 
@@ -0,0 +1,40 @@
+#!/usr/bin/env ruby
+# Copyright (c) 2022 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Usage: build_id.rb <output header> <source>...
+# Writes a header defining ES2PANDA_BUILD_ID as the hash of the given sources.
+
+require 'digest'
+
+out_file = ARGV.shift
+digest = Digest::SHA256.new
+
+ARGV.sort.each do |source|
+  digest.update(File.basename(source))
+  digest.update("\0")
+  digest.update(File.binread(source))
+  digest.update("\0")
+end
+
+content = <<~HEADER
+  // Generated by #{File.basename(__FILE__)}, do not edit
+  #ifndef ES2PANDA_GEN_BUILD_ID_H
+  #define ES2PANDA_GEN_BUILD_ID_H
+
+  #define ES2PANDA_BUILD_ID "#{digest.hexdigest}"
+
+  #endif
+HEADER
+
+File.write(out_file, content)
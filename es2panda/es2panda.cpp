@@ -18,9 +18,11 @@
 #include <compiler/core/compileQueue.h>
 #include <compiler/core/compilerContext.h>
 #include <compiler/core/compilerImpl.h>
+#include <compiler/core/moduleGraph.h>
 #include <parser/parserImpl.h>
 #include <parser/program/program.h>
 
+#include <fstream>
 #include <iostream>
 #include <thread>
 
@@ -32,7 +34,7 @@ constexpr size_t DEFAULT_THREAD_COUNT = 2;
 Compiler::Compiler(ScriptExtension ext) : Compiler(ext, DEFAULT_THREAD_COUNT) {}
 
 Compiler::Compiler(ScriptExtension ext, size_t threadCount)
-    : parser_(new parser::ParserImpl(ext)), compiler_(new compiler::CompilerImpl(threadCount))
+    : extension_(ext), parser_(new parser::ParserImpl(ext)), compiler_(new compiler::CompilerImpl(threadCount))
 {
 }
 
@@ -42,32 +44,126 @@ Compiler::~Compiler()
     delete compiler_;
 }
 
+// With dumpAst the tree is printed as loaded back from the snapshot, the output is the same only if it round trips
+static void DumpSnapshot(const parser::Program &ast, const CompilerOptions &options)
+{
+    std::string data = ast.DumpSnapshot();
+    std::ofstream snapshot(options.astSnapshot, std::ios::out | std::ios::binary | std::ios::trunc);
+    snapshot << data;
+
+    if (!snapshot) {
+        throw Error(ErrorType::GENERIC, "Failed to write AST snapshot: " + options.astSnapshot);
+    }
+
+    if (!options.dumpAst) {
+        return;
+    }
+
+    if (!ast.DumpFromSnapshot(data, std::cout)) {
+        throw Error(ErrorType::GENERIC, "Failed to load AST snapshot: " + options.astSnapshot);
+    }
+
+    std::cout << std::endl;
+}
+
 panda::pandasm::Program *Compiler::Compile(const SourceFile &input, const CompilerOptions &options)
 {
     /* TODO(dbatyai): pass string view */
     std::string fname(input.fileName);
     std::string src(input.source);
+    errors_.clear();
 
     try {
         auto ast = input.isModule ? parser_->ParseModule(fname, src) : parser_->ParseScript(fname, src);
 
-        if (options.dumpAst) {
-            std::cout << ast.Dump() << std::endl;
+        if (options.dumpAst && options.astSnapshot.empty()) {
+            ast.Dump(std::cout);
+            std::cout << std::endl;
+        }
+
+        if (!options.astSnapshot.empty()) {
+            DumpSnapshot(ast, options);
         }
 
         if (options.parseOnly) {
             return nullptr;
         }
 
-        auto *prog = compiler_->Compile(&ast, options);
-
-        return prog;
+        try {
+            return compiler_->Compile(&ast, options);
+        } catch (const class Error &) {
+            errors_ = compiler_->Errors();
+            throw;
+        }
     } catch (const class Error &e) {
         error_ = e;
+
+        /* Parse errors are not recoverable, only the first one is reported */
+        if (errors_.empty()) {
+            errors_.push_back(e);
+        }
+
         return nullptr;
     }
 }
 
+std::vector<CompiledModule> Compiler::CompileProject(const SourceFile &entry, const CompilerOptions &options)
+{
+    compiler::ModuleGraph graph(extension_);
+    std::vector<CompiledModule> modules;
+    errors_.clear();
+    errorFile_.clear();
+
+    try {
+        graph.Load(std::string(entry.fileName), std::string(entry.source));
+    } catch (const class Error &e) {
+        error_ = e;
+        errors_.push_back(e);
+        errorFile_ = graph.CurrentFile();
+        return modules;
+    }
+
+    if (options.dumpAst) {
+        for (const auto &module : graph.Modules()) {
+            module->program.Dump(std::cout);
+            std::cout << std::endl;
+        }
+    }
+
+    if (options.parseOnly) {
+        return modules;
+    }
+
+    graph.Optimize();
+
+    /* The optimizations rewrite the ASTs of the modules, their source text no longer describes the functions */
+    CompilerOptions moduleOptions = options;
+    moduleOptions.cacheDir.clear();
+
+    for (const auto &module : graph.Modules()) {
+        try {
+            modules.push_back({module->fileName, compiler_->Compile(&module->program, moduleOptions)});
+        } catch (const class Error &e) {
+            error_ = e;
+            errors_ = compiler_->Errors();
+            errorFile_ = module->fileName;
+
+            if (errors_.empty()) {
+                errors_.push_back(e);
+            }
+
+            for (auto &it : modules) {
+                delete it.program;
+            }
+
+            modules.clear();
+            break;
+        }
+    }
+
+    return modules;
+}
+
 void Compiler::DumpAsm(const panda::pandasm::Program *prog)
 {
     compiler::CompilerImpl::DumpAsm(prog);
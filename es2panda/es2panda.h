@@ -19,6 +19,7 @@
 #include <macros.h>
 
 #include <string>
+#include <vector>
 
 namespace panda::pandasm {
 struct Program;
@@ -54,6 +55,13 @@ struct CompilerOptions {
     bool dumpAsm {false};
     bool dumpDebugInfo {false};
     bool parseOnly {false};
+    bool skipTypeCheck {false};
+    bool recordType {false};
+    size_t maxErrors {1};
+    // Existing directory of the function cache, see compiler::FunctionCache. Empty to disable the cache
+    std::string cacheDir {};
+    // File the binary snapshot of the parsed AST is written to, see ir::AstSnapshot. Empty to skip the snapshot
+    std::string astSnapshot {};
 };
 
 enum class ErrorType {
@@ -126,6 +134,11 @@ private:
     int errorCode_ {1};
 };
 
+struct CompiledModule {
+    std::string fileName;
+    panda::pandasm::Program *program {};
+};
+
 class Compiler {
 public:
     explicit Compiler(ScriptExtension ext);
@@ -143,6 +156,10 @@ public:
         return Compile(input, options);
     }
 
+    // Compiles the entry module and every module it reaches through relative specifiers, see
+    // compiler::ModuleGraph. The entry module comes first, nothing is returned on error.
+    std::vector<CompiledModule> CompileProject(const SourceFile &entry, const CompilerOptions &options);
+
     static void DumpAsm(const panda::pandasm::Program *prog);
 
     const Error &GetError() const noexcept
@@ -150,10 +167,25 @@ public:
         return error_;
     }
 
+    // All errors reported by the last Compile call, starting with GetError()
+    const std::vector<Error> &GetErrors() const noexcept
+    {
+        return errors_;
+    }
+
+    // Module of the errors reported by the last CompileProject call
+    const std::string &GetErrorFile() const noexcept
+    {
+        return errorFile_;
+    }
+
 private:
+    ScriptExtension extension_;
     parser::ParserImpl *parser_;
     compiler::CompilerImpl *compiler_;
     Error error_;
+    std::vector<Error> errors_;
+    std::string errorFile_;
 };
 }  // namespace panda::es2panda
 
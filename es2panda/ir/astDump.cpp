@@ -16,24 +16,53 @@
 #include "astDump.h"
 
 #include <ir/astNode.h>
+#include <ir/astSnapshot.h>
 
 #include <cmath>
 #include <iostream>
 
 namespace panda::es2panda::ir {
 
-AstDumper::AstDumper(const BlockStatement *program, util::StringView sourceCode) : index_(sourceCode), indent_(0)
+AstDumper::AstDumper(const BlockStatement *program, util::StringView sourceCode)
+    : index_(sourceCode), out_(ss_), indent_(0)
 {
     SerializeObject(reinterpret_cast<const ir::AstNode *>(program));
 }
 
+AstDumper::AstDumper(const BlockStatement *program, util::StringView sourceCode, std::ostream &out)
+    : index_(sourceCode), out_(out), indent_(0)
+{
+    SerializeObject(reinterpret_cast<const ir::AstNode *>(program));
+}
+
+AstDumper::AstDumper(util::StringView sourceCode, std::ostream &out) : index_(sourceCode), out_(out), indent_(0) {}
+
+AstDumper::AstDumper(const BlockStatement *program, AstSnapshotWriter *snapshot)
+    : index_(util::StringView()), out_(ss_), indent_(0), snapshot_(snapshot)
+{
+    snapshot_->WriteNode(this, reinterpret_cast<const ir::AstNode *>(program));
+}
+
 void AstDumper::Add(std::initializer_list<AstDumper::Property> props)
 {
+    if (snapshot_) {
+        for (const auto &prop : props) {
+            snapshot_->WriteProperty(this, prop);
+        }
+
+        return;
+    }
+
     AddList<std::initializer_list<AstDumper::Property>>(props);
 }
 
 void AstDumper::Add(const AstDumper::Property &prop)
 {
+    if (snapshot_) {
+        snapshot_->WriteProperty(this, prop);
+        return;
+    }
+
     Serialize(prop);
 }
 
@@ -99,55 +128,63 @@ void AstDumper::Serialize(const AstDumper::Property &prop)
 
 void AstDumper::SerializeToken(lexer::TokenType token)
 {
-    ss_ << "\"" << lexer::TokenToString(token) << "\"";
+    out_ << "\"" << lexer::TokenToString(token) << "\"";
 }
 
 void AstDumper::SerializePropKey(const char *str)
 {
-    ss_ << std::endl;
+    out_ << '\n';
+    Indent();
+    SerializeString(str);
+    out_ << ": ";
+}
+
+void AstDumper::SerializePropKey(const util::StringView &str)
+{
+    out_ << '\n';
     Indent();
     SerializeString(str);
-    ss_ << ": ";
+    out_ << ": ";
 }
 
 void AstDumper::SerializeString(const char *str)
 {
-    ss_ << "\"" << str << "\"";
+    out_ << "\"" << str << "\"";
 }
 
 void AstDumper::SerializeString(const util::StringView &str)
 {
-    ss_ << "\"" << str.Utf8() << "\"";
+    out_ << "\"" << str.Utf8() << "\"";
 }
 
 void AstDumper::SerializeNumber(size_t number)
 {
-    ss_ << number;
+    out_ << number;
 }
 
 void AstDumper::SerializeNumber(double number)
 {
     if (std::isinf(number)) {
-        ss_ << "\"Infinity\"";
+        out_ << "\"Infinity\"";
     } else {
-        ss_ << number;
+        out_ << number;
     }
 }
 
 void AstDumper::SerializeBoolean(bool boolean)
 {
-    ss_ << (boolean ? "true" : "false");
+    out_ << (boolean ? "true" : "false");
 }
 
 void AstDumper::SerializeConstant(Property::Constant constant)
 {
     switch (constant) {
         case Property::Constant::PROP_NULL: {
-            ss_ << "null";
+            out_ << "null";
             break;
         }
         case Property::Constant::EMPTY_ARRAY: {
-            ss_ << "[]";
+            out_ << "[]";
             break;
         }
         default: {
@@ -162,7 +199,7 @@ void AstDumper::SerializePropList(std::initializer_list<AstDumper::Property> pro
         for (const auto *it = props.begin(); it != props.end(); ++it) {
             Serialize(*it);
             if (std::next(it) != props.end()) {
-                ss_ << ',';
+                out_ << ',';
             }
         }
     });
@@ -173,13 +210,13 @@ void AstDumper::SerializeArray(std::vector<const ir::AstNode *> array)
     Wrap(
         [this, &array]() -> void {
             for (auto it = array.begin(); it != array.end(); ++it) {
-                ss_ << std::endl;
+                out_ << '\n';
                 Indent();
 
                 SerializeObject(*it);
 
                 if (std::next(it) != array.end()) {
-                    ss_ << ',';
+                    out_ << ',';
                 }
             }
         },
@@ -196,25 +233,25 @@ void AstDumper::SerializeObject(const ir::AstNode *object)
 
 void AstDumper::Wrap(const WrapperCb &cb, char delimStart, char delimEnd)
 {
-    ss_ << delimStart;
+    out_ << delimStart;
     indent_++;
 
     cb();
-    ss_ << std::endl;
+    out_ << '\n';
     indent_--;
     Indent();
-    ss_ << delimEnd;
+    out_ << delimEnd;
 }
 
 void AstDumper::SerializeLoc(const lexer::SourceRange &loc)
 {
-    ss_ << ',';
+    out_ << ',';
     SerializePropKey("loc");
 
     Wrap([this, &loc]() -> void {
         SerializePropKey("start");
         SerializeSourcePosition(loc.start);
-        ss_ << ',';
+        out_ << ',';
         SerializePropKey("end");
         SerializeSourcePosition(loc.end);
     });
@@ -227,7 +264,7 @@ void AstDumper::SerializeSourcePosition(const lexer::SourcePosition &pos)
     Wrap([this, &loc]() -> void {
         SerializePropKey("line");
         SerializeNumber(loc.line);
-        ss_ << ',';
+        out_ << ',';
         SerializePropKey("column");
         SerializeNumber(loc.col);
     });
@@ -236,7 +273,7 @@ void AstDumper::SerializeSourcePosition(const lexer::SourcePosition &pos)
 void AstDumper::Indent()
 {
     for (int32_t i = 0; i < indent_; i++) {
-        ss_ << "  ";
+        out_ << "  ";
     }
 }
 
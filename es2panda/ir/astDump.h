@@ -21,11 +21,15 @@
 #include <lexer/token/tokenType.h>
 #include <util/ustring.h>
 
+#include <ostream>
 #include <sstream>
 #include <variant>
 
 namespace panda::es2panda::ir {
 
+class AstSnapshotPrinter;
+class AstSnapshotWriter;
+
 class AstDumper {
 public:
     class Nullable {
@@ -146,6 +150,10 @@ public:
     };
 
     explicit AstDumper(const BlockStatement *program, util::StringView sourceCode);
+    // Writes the nodes to out while they are visited, only the path to the current node is kept in memory
+    explicit AstDumper(const BlockStatement *program, util::StringView sourceCode, std::ostream &out);
+    // Hands the properties of the nodes to the snapshot writer instead of printing them
+    explicit AstDumper(const BlockStatement *program, AstSnapshotWriter *snapshot);
 
     void Add(std::initializer_list<Property> props);
     void Add(const AstDumper::Property &prop);
@@ -153,14 +161,20 @@ public:
     static const char *ModifierToString(ModifierFlags flags);
     static const char *TypeOperatorToString(TSOperatorType operatorType);
 
+    // Output of the dumpers that were not given a stream
     std::string Str() const
     {
         return ss_.str();
     }
 
 private:
+    friend class AstSnapshotPrinter;
+
     using WrapperCb = std::function<void()>;
 
+    // Formats the nodes of a loaded snapshot, see AstSnapshot::Dump
+    explicit AstDumper(util::StringView sourceCode, std::ostream &out);
+
     template <typename T>
     void AddList(T props)
     {
@@ -173,7 +187,7 @@ private:
                 }
             } while (std::holds_alternative<Property::Ignore>((*it).Value()));
 
-            ss_ << ',';
+            out_ << ',';
         }
     }
 
@@ -181,6 +195,7 @@ private:
 
     void Serialize(const AstDumper::Property &prop);
     void SerializePropKey(const char *str);
+    void SerializePropKey(const util::StringView &str);
     void SerializeString(const char *str);
     void SerializeString(const util::StringView &str);
     void SerializeNumber(size_t number);
@@ -199,7 +214,9 @@ private:
 
     lexer::LineIndex index_;
     std::stringstream ss_;
+    std::ostream &out_;
     int32_t indent_;
+    AstSnapshotWriter *snapshot_ {};
 };
 }  // namespace panda::es2panda::ir
 
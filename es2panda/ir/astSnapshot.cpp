@@ -0,0 +1,463 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "astSnapshot.h"
+
+#include <ir/astNodeMapping.h>
+
+#include <cstring>
+#include <vector>
+
+namespace panda::es2panda::ir {
+
+/*
+ * Layout, integers are LEB128 encoded:
+ *   snapshot := MAGIC node
+ *   node     := type start.index start.line end.index end.line property* END
+ *   property := tag key value
+ *   key      := id, followed by the length and the bytes of the key when it is used for the first time
+ *   value    := nothing for NULL_VALUE, FALSE and TRUE, 8 bytes for NUMBER, length and bytes for STRING,
+ *               token type for TOKEN, a node for NODE, count and nodes for ARRAY, property* END for PROPERTIES
+ */
+constexpr std::string_view MAGIC = "ES2PAST\x01";
+
+enum class SnapshotTag : uint8_t {
+    END,
+    NULL_VALUE,
+    FALSE,
+    TRUE,
+    NUMBER,
+    STRING,
+    TOKEN,
+    NODE,
+    ARRAY,
+    PROPERTIES,
+};
+
+#define COUNT_NODE_TYPE(nodeType, className) +1
+#define COUNT_REINTERPRET_NODE_TYPES(nodeType1, nodeType2, baseClass, reinterpretClass) +2
+constexpr uint64_t NODE_TYPE_COUNT =
+    0 AST_NODE_MAPPING(COUNT_NODE_TYPE) AST_NODE_REINTERPRET_MAPPING(COUNT_REINTERPRET_NODE_TYPES);
+#undef COUNT_REINTERPRET_NODE_TYPES
+#undef COUNT_NODE_TYPE
+
+const AstSnapshot::Value *AstSnapshot::Node::Find(std::string_view key) const
+{
+    for (const auto &prop : properties_) {
+        if (prop.key.Utf8() == key) {
+            return &prop.value;
+        }
+    }
+
+    return nullptr;
+}
+
+// AstSnapshotWriter
+
+AstSnapshotWriter::AstSnapshotWriter() : buffer_(MAGIC) {}
+
+void AstSnapshotWriter::WriteVarint(uint64_t value)
+{
+    constexpr uint64_t PAYLOAD_MASK = 0x7f;
+    constexpr uint8_t CONTINUATION_BIT = 0x80;
+    constexpr uint64_t PAYLOAD_BITS = 7;
+
+    while (value > PAYLOAD_MASK) {
+        buffer_.push_back(static_cast<char>((value & PAYLOAD_MASK) | CONTINUATION_BIT));
+        value >>= PAYLOAD_BITS;
+    }
+
+    buffer_.push_back(static_cast<char>(value));
+}
+
+void AstSnapshotWriter::WriteString(std::string_view str)
+{
+    WriteVarint(str.size());
+    buffer_.append(str);
+}
+
+void AstSnapshotWriter::WriteKey(const char *key)
+{
+    auto [iter, inserted] = keys_.emplace(key, keys_.size());
+    WriteVarint(iter->second);
+
+    if (inserted) {
+        WriteString(iter->first);
+    }
+}
+
+void AstSnapshotWriter::WriteEnd()
+{
+    buffer_.push_back(static_cast<char>(SnapshotTag::END));
+}
+
+void AstSnapshotWriter::WriteNode(AstDumper *dumper, const AstNode *node)
+{
+    const auto &range = node->Range();
+
+    WriteVarint(static_cast<uint64_t>(node->Type()));
+    WriteVarint(range.start.index);
+    WriteVarint(range.start.line);
+    WriteVarint(range.end.index);
+    WriteVarint(range.end.line);
+
+    /* The visitor reports the properties of the node back through WriteProperty */
+    node->Dump(dumper);
+    WriteEnd();
+}
+
+void AstSnapshotWriter::WriteProperty(AstDumper *dumper, const AstDumper::Property &prop)
+{
+    const auto &value = prop.Value();
+
+    if (std::holds_alternative<AstDumper::Property::Ignore>(value)) {
+        return;
+    }
+
+    auto writeHeader = [this, &prop](SnapshotTag tag) {
+        buffer_.push_back(static_cast<char>(tag));
+        WriteKey(prop.Key());
+    };
+
+    if (std::holds_alternative<const char *>(value)) {
+        writeHeader(SnapshotTag::STRING);
+        WriteString(std::get<const char *>(value));
+    } else if (std::holds_alternative<util::StringView>(value)) {
+        writeHeader(SnapshotTag::STRING);
+        WriteString(std::get<util::StringView>(value).Utf8());
+    } else if (std::holds_alternative<bool>(value)) {
+        writeHeader(std::get<bool>(value) ? SnapshotTag::TRUE : SnapshotTag::FALSE);
+    } else if (std::holds_alternative<double>(value)) {
+        writeHeader(SnapshotTag::NUMBER);
+        double number = std::get<double>(value);
+        char bytes[sizeof(double)];
+        std::memcpy(bytes, &number, sizeof(double));
+        buffer_.append(bytes, sizeof(double));
+    } else if (std::holds_alternative<const ir::AstNode *>(value)) {
+        writeHeader(SnapshotTag::NODE);
+        WriteNode(dumper, std::get<const ir::AstNode *>(value));
+    } else if (std::holds_alternative<std::vector<const ir::AstNode *>>(value)) {
+        const auto &nodes = std::get<std::vector<const ir::AstNode *>>(value);
+        writeHeader(SnapshotTag::ARRAY);
+        WriteVarint(nodes.size());
+
+        for (const auto *node : nodes) {
+            WriteNode(dumper, node);
+        }
+    } else if (std::holds_alternative<lexer::TokenType>(value)) {
+        writeHeader(SnapshotTag::TOKEN);
+        WriteVarint(static_cast<uint64_t>(std::get<lexer::TokenType>(value)));
+    } else if (std::holds_alternative<std::initializer_list<AstDumper::Property>>(value)) {
+        writeHeader(SnapshotTag::PROPERTIES);
+
+        for (const auto &it : std::get<std::initializer_list<AstDumper::Property>>(value)) {
+            WriteProperty(dumper, it);
+        }
+
+        WriteEnd();
+    } else if (std::holds_alternative<AstDumper::Property::Constant>(value)) {
+        if (std::get<AstDumper::Property::Constant>(value) == AstDumper::Property::Constant::EMPTY_ARRAY) {
+            writeHeader(SnapshotTag::ARRAY);
+            WriteVarint(0);
+        } else {
+            writeHeader(SnapshotTag::NULL_VALUE);
+        }
+    }
+}
+
+// AstSnapshotReader
+
+class AstSnapshotReader {
+public:
+    AstSnapshotReader(ArenaAllocator *allocator, std::string_view data) : allocator_(allocator), data_(data) {}
+
+    const AstSnapshot::Node *ReadSnapshot()
+    {
+        if (data_.substr(0, MAGIC.size()) != MAGIC) {
+            return nullptr;
+        }
+
+        pos_ = MAGIC.size();
+        const auto *root = ReadNode();
+
+        return ok_ && pos_ == data_.size() ? root : nullptr;
+    }
+
+private:
+    uint64_t ReadVarint()
+    {
+        constexpr uint64_t PAYLOAD_MASK = 0x7f;
+        constexpr uint8_t CONTINUATION_BIT = 0x80;
+        constexpr uint64_t PAYLOAD_BITS = 7;
+        constexpr uint64_t MAX_SHIFT = 63;
+
+        uint64_t value = 0;
+
+        for (uint64_t shift = 0; shift <= MAX_SHIFT; shift += PAYLOAD_BITS) {
+            if (pos_ == data_.size()) {
+                break;
+            }
+
+            auto byte = static_cast<uint8_t>(data_[pos_++]);
+            value |= (byte & PAYLOAD_MASK) << shift;
+
+            if ((byte & CONTINUATION_BIT) == 0) {
+                return value;
+            }
+        }
+
+        ok_ = false;
+        return 0;
+    }
+
+    util::StringView ReadString()
+    {
+        auto size = ReadVarint();
+
+        if (data_.size() - pos_ < size) {
+            ok_ = false;
+            return util::StringView();
+        }
+
+        util::StringView str(data_.substr(pos_, size));
+        pos_ += size;
+        return str;
+    }
+
+    util::StringView ReadKey()
+    {
+        auto id = ReadVarint();
+
+        if (id == keys_.size()) {
+            keys_.push_back(ReadString());
+        } else if (id > keys_.size()) {
+            ok_ = false;
+            return util::StringView();
+        }
+
+        return keys_[id];
+    }
+
+    const AstSnapshot::Node *ReadNode()
+    {
+        /* Read in the order WriteNode writes, arguments of one call are evaluated in unspecified order */
+        auto type = ReadVarint();
+        auto startIndex = ReadVarint();
+        auto startLine = ReadVarint();
+        auto endIndex = ReadVarint();
+        auto endLine = ReadVarint();
+        lexer::SourcePosition start(startIndex, startLine);
+        lexer::SourcePosition end(endIndex, endLine);
+
+        if (type >= NODE_TYPE_COUNT) {
+            ok_ = false;
+            return nullptr;
+        }
+
+        auto *node = allocator_->New<AstSnapshot::Node>(allocator_, static_cast<AstNodeType>(type),
+                                                        lexer::SourceRange(start, end));
+        ReadProperties(&node->Properties());
+        return node;
+    }
+
+    void ReadProperties(AstSnapshot::PropertyList *props)
+    {
+        while (ok_) {
+            if (pos_ == data_.size()) {
+                ok_ = false;
+                return;
+            }
+
+            auto tag = static_cast<SnapshotTag>(data_[pos_++]);
+
+            if (tag == SnapshotTag::END) {
+                return;
+            }
+
+            auto key = ReadKey();
+            props->push_back({key, ReadValue(tag)});
+        }
+    }
+
+    AstSnapshot::Value ReadValue(SnapshotTag tag)
+    {
+        switch (tag) {
+            case SnapshotTag::NULL_VALUE: {
+                return std::monostate {};
+            }
+            case SnapshotTag::FALSE:
+            case SnapshotTag::TRUE: {
+                return tag == SnapshotTag::TRUE;
+            }
+            case SnapshotTag::NUMBER: {
+                double number = 0;
+
+                if (data_.size() - pos_ < sizeof(double)) {
+                    ok_ = false;
+                    return number;
+                }
+
+                std::memcpy(&number, data_.data() + pos_, sizeof(double));
+                pos_ += sizeof(double);
+                return number;
+            }
+            case SnapshotTag::STRING: {
+                return ReadString();
+            }
+            case SnapshotTag::TOKEN: {
+                return static_cast<lexer::TokenType>(ReadVarint());
+            }
+            case SnapshotTag::NODE: {
+                return ReadNode();
+            }
+            case SnapshotTag::ARRAY: {
+                auto count = ReadVarint();
+                auto *nodes = allocator_->New<AstSnapshot::NodeList>(allocator_->Adapter());
+
+                /* Every node takes at least six bytes, a larger count can only come from a damaged snapshot */
+                if (count > data_.size() - pos_) {
+                    ok_ = false;
+                    return nodes;
+                }
+
+                nodes->reserve(count);
+
+                for (uint64_t i = 0; i < count && ok_; i++) {
+                    nodes->push_back(ReadNode());
+                }
+
+                return nodes;
+            }
+            case SnapshotTag::PROPERTIES: {
+                auto *props = allocator_->New<AstSnapshot::PropertyList>(allocator_->Adapter());
+                ReadProperties(props);
+                return props;
+            }
+            default: {
+                ok_ = false;
+                return std::monostate {};
+            }
+        }
+    }
+
+    ArenaAllocator *allocator_;
+    std::string_view data_;
+    size_t pos_ {0};
+    std::vector<util::StringView> keys_;
+    bool ok_ {true};
+};
+
+// AstSnapshotPrinter
+
+class AstSnapshotPrinter {
+public:
+    AstSnapshotPrinter(util::StringView sourceCode, std::ostream &out) : dumper_(sourceCode, out) {}
+
+    void PrintNode(const AstSnapshot::Node *node)
+    {
+        dumper_.Wrap([this, node]() -> void {
+            PrintProperties(node->Properties());
+            dumper_.SerializeLoc(node->Range());
+        });
+    }
+
+private:
+    void PrintProperties(const AstSnapshot::PropertyList &props)
+    {
+        for (auto it = props.begin(); it != props.end(); ++it) {
+            if (it != props.begin()) {
+                dumper_.out_ << ',';
+            }
+
+            dumper_.SerializePropKey(it->key);
+            PrintValue(it->value);
+        }
+    }
+
+    void PrintValue(const AstSnapshot::Value &value)
+    {
+        if (std::holds_alternative<std::monostate>(value)) {
+            dumper_.SerializeConstant(AstDumper::Property::Constant::PROP_NULL);
+        } else if (std::holds_alternative<bool>(value)) {
+            dumper_.SerializeBoolean(std::get<bool>(value));
+        } else if (std::holds_alternative<double>(value)) {
+            dumper_.SerializeNumber(std::get<double>(value));
+        } else if (std::holds_alternative<util::StringView>(value)) {
+            dumper_.SerializeString(std::get<util::StringView>(value));
+        } else if (std::holds_alternative<lexer::TokenType>(value)) {
+            dumper_.SerializeToken(std::get<lexer::TokenType>(value));
+        } else if (std::holds_alternative<const AstSnapshot::Node *>(value)) {
+            PrintNode(std::get<const AstSnapshot::Node *>(value));
+        } else if (std::holds_alternative<const AstSnapshot::NodeList *>(value)) {
+            PrintNodeList(*std::get<const AstSnapshot::NodeList *>(value));
+        } else if (std::holds_alternative<const AstSnapshot::PropertyList *>(value)) {
+            const auto *props = std::get<const AstSnapshot::PropertyList *>(value);
+            dumper_.Wrap([this, props]() -> void { PrintProperties(*props); });
+        }
+    }
+
+    void PrintNodeList(const AstSnapshot::NodeList &nodes)
+    {
+        /* The writer stores empty arrays the same way, whichever form the dumper got them in */
+        if (nodes.empty()) {
+            dumper_.SerializeConstant(AstDumper::Property::Constant::EMPTY_ARRAY);
+            return;
+        }
+
+        dumper_.Wrap(
+            [this, &nodes]() -> void {
+                for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+                    dumper_.out_ << '\n';
+                    dumper_.Indent();
+
+                    PrintNode(*it);
+
+                    if (std::next(it) != nodes.end()) {
+                        dumper_.out_ << ',';
+                    }
+                }
+            },
+            '[', ']');
+    }
+
+    AstDumper dumper_;
+};
+
+// AstSnapshot
+
+std::string AstSnapshot::Save(const BlockStatement *program)
+{
+    AstSnapshotWriter writer;
+    AstDumper dumper(program, &writer);
+    return writer.Buffer();
+}
+
+const AstSnapshot::Node *AstSnapshot::Load(ArenaAllocator *allocator, std::string_view data)
+{
+    /* The strings of the nodes refer to the copy, which lives as long as the nodes */
+    auto *copy = static_cast<char *>(allocator->Alloc(data.size()));
+    std::memcpy(copy, data.data(), data.size());
+
+    AstSnapshotReader reader(allocator, std::string_view(copy, data.size()));
+    return reader.ReadSnapshot();
+}
+
+void AstSnapshot::Dump(const Node *root, util::StringView sourceCode, std::ostream &out)
+{
+    AstSnapshotPrinter printer(sourceCode, out);
+    printer.PrintNode(root);
+}
+
+}  // namespace panda::es2panda::ir
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES2PANDA_IR_AST_SNAPSHOT_H
+#define ES2PANDA_IR_AST_SNAPSHOT_H
+
+#include <ir/astDump.h>
+#include <ir/astNode.h>
+#include <lexer/token/sourceLocation.h>
+#include <lexer/token/tokenType.h>
+#include <util/ustring.h>
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+
+namespace panda::es2panda::ir {
+
+// Compact binary form of the tree reported by the Dump visitors of the nodes, the same tree AstDumper prints as JSON.
+// Tools load a snapshot into an arena far faster than they could lex and parse the source again.
+class AstSnapshot {
+public:
+    class Node;
+    struct Property;
+
+    using NodeList = ArenaVector<const Node *>;
+    using PropertyList = ArenaVector<Property>;
+    // Null, boolean, number, string, token, node, array of nodes and nested property list
+    using Value = std::variant<std::monostate, bool, double, util::StringView, lexer::TokenType, const Node *,
+                               const NodeList *, const PropertyList *>;
+
+    struct Property {
+        util::StringView key;
+        Value value;
+    };
+
+    class Node {
+    public:
+        Node(ArenaAllocator *allocator, AstNodeType type, const lexer::SourceRange &range)
+            : type_(type), range_(range), properties_(allocator->Adapter())
+        {
+        }
+
+        AstNodeType Type() const
+        {
+            return type_;
+        }
+
+        const lexer::SourceRange &Range() const
+        {
+            return range_;
+        }
+
+        const PropertyList &Properties() const
+        {
+            return properties_;
+        }
+
+        PropertyList &Properties()
+        {
+            return properties_;
+        }
+
+        // Returns nullptr if the node has no property with the given key
+        const Value *Find(std::string_view key) const;
+
+    private:
+        AstNodeType type_;
+        lexer::SourceRange range_;
+        PropertyList properties_;
+    };
+
+    AstSnapshot() = delete;
+
+    static std::string Save(const BlockStatement *program);
+
+    // Returns nullptr if data is not a snapshot. The strings of the nodes refer to a copy of data in the arena.
+    static const Node *Load(ArenaAllocator *allocator, std::string_view data);
+
+    // Prints a loaded tree as AstDumper prints the parsed one, sourceCode is the source the snapshot was saved from
+    static void Dump(const Node *root, util::StringView sourceCode, std::ostream &out);
+};
+
+// Encodes the properties an AstDumper receives from the Dump visitors, see AstSnapshot
+class AstSnapshotWriter {
+public:
+    AstSnapshotWriter();
+    NO_COPY_SEMANTIC(AstSnapshotWriter);
+    NO_MOVE_SEMANTIC(AstSnapshotWriter);
+    ~AstSnapshotWriter() = default;
+
+    void WriteNode(AstDumper *dumper, const AstNode *node);
+    void WriteProperty(AstDumper *dumper, const AstDumper::Property &prop);
+    void WriteEnd();
+
+    const std::string &Buffer() const
+    {
+        return buffer_;
+    }
+
+private:
+    void WriteVarint(uint64_t value);
+    void WriteString(std::string_view str);
+    void WriteKey(const char *key);
+
+    std::string buffer_;
+    std::unordered_map<std::string_view, uint64_t> keys_;
+};
+
+}  // namespace panda::es2panda::ir
+
+#endif
@@ -131,6 +131,11 @@ int32_t ClassDefinition::CreateClassStaticProperties(compiler::PandaGen *pg, uti
         }
         const ir::MethodDefinition *prop = properties[i]->AsMethodDefinition();
 
+        if (prop->Value()->AsFunctionExpression()->Function()->IsOverload()) {
+            compiled.Set(i);
+            continue;
+        }
+
         if (!util::Helpers::IsConstantPropertyKey(prop->Key(), prop->Computed()) ||
             (prop->Computed() && util::Helpers::IsSpecialPropertyKey(prop->Key()))) {
             seenComputed = true;
@@ -187,7 +192,7 @@ int32_t ClassDefinition::CreateClassStaticProperties(compiler::PandaGen *pg, uti
      * is divided by 2 as key/value pairs count as one. */
     buf->Add(pg->Allocator()->New<NumberLiteral>(litPairs));
 
-    return pg->AddLiteralBuffer(buf);
+    return pg->AddLiteralBuffer(buf, compiler::LiteralBufferKind::CLASS);
 }
 
 void ClassDefinition::CompileMissingProperties(compiler::PandaGen *pg, const util::BitSet &compiled,
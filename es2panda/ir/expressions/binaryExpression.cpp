@@ -16,6 +16,8 @@
 #include "binaryExpression.h"
 
 #include <binder/variable.h>
+#include <compiler/base/concatenation.h>
+#include <compiler/base/constantFolding.h>
 #include <compiler/core/pandagen.h>
 #include <compiler/core/regScope.h>
 #include <typescript/checker.h>
@@ -77,11 +79,20 @@ void BinaryExpression::CompileLogical(compiler::PandaGen *pg) const
 
 void BinaryExpression::Compile(compiler::PandaGen *pg) const
 {
+    if (compiler::ConstantFolding::TryCompile(pg, this)) {
+        return;
+    }
+
     if (IsLogical()) {
         CompileLogical(pg);
         return;
     }
 
+    if (operator_ == lexer::TokenType::PUNCTUATOR_PLUS) {
+        compiler::Concatenation::CompileChain(pg, this);
+        return;
+    }
+
     compiler::RegScope rs(pg);
     compiler::VReg lhs = pg->AllocReg();
 
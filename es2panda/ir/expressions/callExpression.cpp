@@ -16,6 +16,7 @@
 #include "callExpression.h"
 
 #include <util/helpers.h>
+#include <compiler/core/function.h>
 #include <compiler/core/pandagen.h>
 #include <compiler/core/regScope.h>
 #include <typescript/checker.h>
@@ -100,6 +101,11 @@ void CallExpression::Compile(compiler::PandaGen *pg) const
 
         pg->LoadAccumulator(this, newThis);
         pg->SetThis(this);
+
+        const auto *ctor = util::Helpers::GetContainingConstructor(this);
+        if (ctor != nullptr && compiler::Function::CompileParameterProperties(pg, ctor)) {
+            pg->LoadAccumulator(this, newThis);
+        }
         return;
     }
 
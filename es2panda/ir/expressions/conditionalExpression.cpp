@@ -16,6 +16,7 @@
 #include "conditionalExpression.h"
 
 #include <compiler/base/condition.h>
+#include <compiler/base/constantFolding.h>
 #include <compiler/core/pandagen.h>
 #include <typescript/checker.h>
 #include <ir/astDump.h>
@@ -37,6 +38,16 @@ void ConditionalExpression::Dump(ir::AstDumper *dumper) const
 
 void ConditionalExpression::Compile(compiler::PandaGen *pg) const
 {
+    if (compiler::ConstantFolding::TryCompile(pg, this)) {
+        return;
+    }
+
+    bool testResult = false;
+    if (compiler::ConstantFolding::TryFoldCondition(test_, &testResult)) {
+        (testResult ? consequent_ : alternate_)->Compile(pg);
+        return;
+    }
+
     auto *falseLabel = pg->AllocLabel();
     auto *endLabel = pg->AllocLabel();
 
@@ -106,6 +106,16 @@ checker::Type *Identifier::Check(checker::Checker *checker) const
             }
             case binder::DeclType::PARAM:
             case binder::DeclType::VAR: {
+                if (decl->Node()->IsTSEnumDeclaration()) {
+                    decl->Node()->Check(checker);
+                    return variable_->TsType();
+                }
+
+                // The objects of namespaces are not typed yet
+                if (decl->Node()->IsTSModuleDeclaration()) {
+                    break;
+                }
+
                 bindingType = checker->InferVariableDeclarationType(decl->Node()->AsIdentifier());
                 break;
             }
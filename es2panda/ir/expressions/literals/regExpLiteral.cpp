@@ -17,7 +17,6 @@
 
 #include <binder/variable.h>
 #include <compiler/core/pandagen.h>
-#include <compiler/core/regScope.h>
 #include <typescript/checker.h>
 #include <ir/astDump.h>
 
@@ -27,33 +26,12 @@ void RegExpLiteral::Iterate([[maybe_unused]] const NodeTraverser &cb) const {}
 
 void RegExpLiteral::Dump(ir::AstDumper *dumper) const
 {
-    dumper->Add({{"type", "RegExpLiteral"}, {"source", pattern_}, {"flags", flags_}});
+    dumper->Add({{"type", "RegExpLiteral"}, {"source", pattern_}, {"flags", flagsStr_}});
 }
 
 void RegExpLiteral::Compile(compiler::PandaGen *pg) const
 {
-    compiler::RegScope rs(pg);
-    /* [ ctor, newTarget, regexpPattern(, regexpFlags) ] */
-    compiler::VReg ctor = pg->AllocReg();
-    compiler::VReg newTarget = pg->AllocReg();
-    compiler::VReg pattern = pg->AllocReg();
-    size_t argCount = 3;
-
-    pg->TryLoadGlobalByName(this, "RegExp");
-    pg->StoreAccumulator(this, ctor);
-    pg->StoreAccumulator(this, newTarget);
-
-    pg->LoadAccumulatorString(this, pattern_);
-    pg->StoreAccumulator(this, pattern);
-
-    if (!flags_.Empty()) {
-        compiler::VReg flag = pg->AllocReg();
-        pg->LoadAccumulatorString(this, flags_);
-        pg->StoreAccumulator(this, flag);
-        argCount++;
-    }
-
-    pg->NewObject(this, ctor, argCount);
+    pg->CreateRegExpWithLiteral(this, pattern_, static_cast<uint8_t>(flags_));
 }
 
 checker::Type *RegExpLiteral::Check(checker::Checker *checker) const
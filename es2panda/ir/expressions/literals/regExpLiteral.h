@@ -17,6 +17,7 @@
 #define ES2PANDA_IR_EXPRESSION_LITERAL_REGEXP_LITERAL_H
 
 #include <ir/expressions/literal.h>
+#include <lexer/regexp/regexp.h>
 #include <util/ustring.h>
 
 namespace panda::es2panda::compiler {
@@ -32,8 +33,8 @@ namespace panda::es2panda::ir {
 
 class RegExpLiteral : public Literal {
 public:
-    explicit RegExpLiteral(util::StringView pattern, util::StringView flags)
-        : Literal(AstNodeType::REGEXP_LITERAL), pattern_(pattern), flags_(flags)
+    explicit RegExpLiteral(util::StringView pattern, lexer::RegExpFlags flags, util::StringView flagsStr)
+        : Literal(AstNodeType::REGEXP_LITERAL), pattern_(pattern), flags_(flags), flagsStr_(flagsStr)
     {
     }
 
@@ -42,11 +43,16 @@ public:
         return pattern_;
     }
 
-    const util::StringView &Flags() const
+    lexer::RegExpFlags Flags() const
     {
         return flags_;
     }
 
+    const util::StringView &FlagsString() const
+    {
+        return flagsStr_;
+    }
+
     LiteralTag Tag() const override
     {
         return LiteralTag::NULL_VALUE;
@@ -59,7 +65,8 @@ public:
 
 private:
     util::StringView pattern_;
-    util::StringView flags_;
+    lexer::RegExpFlags flags_;
+    util::StringView flagsStr_;
 };
 
 }  // namespace panda::es2panda::ir
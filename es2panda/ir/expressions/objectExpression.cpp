@@ -16,6 +16,7 @@
 #include "objectExpression.h"
 
 #include <util/helpers.h>
+#include <compiler/base/constantFolding.h>
 #include <compiler/base/literals.h>
 #include <compiler/core/pandagen.h>
 #include <typescript/checker.h>
@@ -173,7 +174,8 @@ void ObjectExpression::EmitCreateObjectWithBuffer(compiler::PandaGen *pg, compil
         return;
     }
 
-    uint32_t bufIdx = pg->AddLiteralBuffer(buf);
+    uint32_t bufIdx = pg->AddLiteralBuffer(
+        buf, hasMethod ? compiler::LiteralBufferKind::OBJECT_WITH_METHODS : compiler::LiteralBufferKind::OBJECT);
 
     if (hasMethod) {
         pg->CreateObjectHavingMethod(this, bufIdx);
@@ -185,9 +187,10 @@ void ObjectExpression::EmitCreateObjectWithBuffer(compiler::PandaGen *pg, compil
 static const Literal *CreateLiteral(compiler::PandaGen *pg, const ir::Property *prop, util::BitSet *compiled,
                                     size_t propIndex)
 {
-    if (util::Helpers::IsConstantExpr(prop->Value())) {
+    const auto *constant = compiler::ConstantFolding::TryFoldLiteral(pg, prop->Value());
+    if (constant != nullptr) {
         compiled->Set(propIndex);
-        return prop->Value()->AsLiteral();
+        return constant;
     }
 
     if (prop->Kind() != ir::PropertyKind::INIT) {
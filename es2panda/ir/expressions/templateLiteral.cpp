@@ -15,6 +15,8 @@
 
 #include "templateLiteral.h"
 
+#include <compiler/base/concatenation.h>
+#include <compiler/base/constantFolding.h>
 #include <compiler/core/pandagen.h>
 #include <typescript/checker.h>
 #include <ir/astDump.h>
@@ -40,43 +42,11 @@ void TemplateLiteral::Dump(ir::AstDumper *dumper) const
 
 void TemplateLiteral::Compile([[maybe_unused]] compiler::PandaGen *pg) const
 {
-    auto quasisIt = quasis_.begin();
-    auto expressionIt = expressions_.begin();
-
-    pg->LoadAccumulatorString(this, (*quasisIt)->Raw());
-
-    quasisIt++;
-
-    bool isQuais = false;
-    size_t total = quasis_.size() + expressions_.size();
-
-    compiler::RegScope rs(pg);
-    compiler::VReg lhs = pg->AllocReg();
-
-    while (total != 1) {
-        const ir::AstNode *node = nullptr;
-
-        if (isQuais) {
-            pg->StoreAccumulator(*quasisIt, lhs);
-            pg->LoadAccumulatorString(this, (*quasisIt)->Raw());
-
-            node = *quasisIt;
-            quasisIt++;
-        } else {
-            const ir::Expression *element = *expressionIt;
-            pg->StoreAccumulator(element, lhs);
-
-            element->Compile(pg);
-
-            node = element;
-            expressionIt++;
-        }
-
-        pg->Binary(node, lexer::TokenType::PUNCTUATOR_PLUS, lhs);
-
-        isQuais = !isQuais;
-        total--;
+    if (compiler::ConstantFolding::TryCompile(pg, this)) {
+        return;
     }
+
+    compiler::Concatenation::CompileTemplate(pg, this);
 }
 
 checker::Type *TemplateLiteral::Check([[maybe_unused]] checker::Checker *checker) const
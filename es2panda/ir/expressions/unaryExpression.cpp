@@ -16,6 +16,7 @@
 #include "unaryExpression.h"
 
 #include <binder/variable.h>
+#include <compiler/base/constantFolding.h>
 #include <compiler/core/pandagen.h>
 #include <typescript/checker.h>
 #include <ir/astDump.h>
@@ -38,6 +39,10 @@ void UnaryExpression::Dump(ir::AstDumper *dumper) const
 
 void UnaryExpression::Compile(compiler::PandaGen *pg) const
 {
+    if (compiler::ConstantFolding::TryCompile(pg, this)) {
+        return;
+    }
+
     switch (operator_) {
         case lexer::TokenType::KEYW_DELETE: {
             if (argument_->IsIdentifier()) {
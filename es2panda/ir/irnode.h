@@ -118,8 +118,38 @@ public:
     virtual size_t Registers([[maybe_unused]] std::array<const VReg *, MAX_REG_OPERAND> *regs) const = 0;
     virtual void Transform(panda::pandasm::Ins *ins) const = 0;
 
+    const Format *GetFormat() const
+    {
+        return format_;
+    }
+
+    void SetFormat(const Format *format)
+    {
+        format_ = format;
+        size_ = 0;
+
+        if (format_ == nullptr) {
+            return;
+        }
+
+        // opcode
+        size_ = 1;
+
+        for (const auto &formatItem : format_->GetFormatItem()) {
+            size_ += formatItem.Bitwidth() / 8;  // 8: bits per byte
+        }
+    }
+
+    // Encoded size in bytes of the format chosen by register allocation, 0 for pseudo instructions
+    size_t Size() const
+    {
+        return size_;
+    }
+
 private:
     const ir::AstNode *node_;
+    const Format *format_ {};
+    size_t size_ {0};
 };
 
 }  // namespace panda::es2panda::compiler
@@ -15,6 +15,7 @@
 
 #include "exportDefaultDeclaration.h"
 
+#include <binder/scope.h>
 #include <compiler/core/pandagen.h>
 #include <ir/astDump.h>
 
@@ -34,7 +35,10 @@ void ExportDefaultDeclaration::Dump(ir::AstDumper *dumper) const
 void ExportDefaultDeclaration::Compile([[maybe_unused]] compiler::PandaGen *pg) const
 {
     decl_->Compile(pg);
-    pg->StoreModuleVar(this, "default");
+
+    if (!pg->Scope()->AsModuleScope()->IsRemovedExport("default")) {
+        pg->StoreModuleVar(this, "default");
+    }
 }
 
 checker::Type *ExportDefaultDeclaration::Check([[maybe_unused]] checker::Checker *checker) const
@@ -50,6 +50,11 @@ public:
         return statements_;
     }
 
+    ArenaVector<Statement *> &Statements()
+    {
+        return statements_;
+    }
+
     void Iterate(const NodeTraverser &cb) const override;
     void Dump(ir::AstDumper *dumper) const override;
     void Compile([[maybe_unused]] compiler::PandaGen *pg) const override;
@@ -39,6 +39,10 @@ void ClassDeclaration::Dump(ir::AstDumper *dumper) const
 
 void ClassDeclaration::Compile([[maybe_unused]] compiler::PandaGen *pg) const
 {
+    if (def_->Declare()) {
+        return;
+    }
+
     auto lref = compiler::LReference::CreateLRef(pg, def_->Ident(), true);
     def_->Compile(pg);
     lref.SetValue();
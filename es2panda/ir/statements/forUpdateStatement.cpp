@@ -80,6 +80,8 @@ void ForUpdateStatement::Compile([[maybe_unused]] compiler::PandaGen *pg) const
     }
 
     if (update_) {
+        // The update runs in the per-iteration env, whose slots may differ from the declaration's
+        compiler::ScopeContext scopeCtx(pg, scope_);
         update_->Compile(pg);
     }
 
@@ -63,6 +63,10 @@ void VariableDeclaration::Dump(ir::AstDumper *dumper) const
 
 void VariableDeclaration::Compile(compiler::PandaGen *pg) const
 {
+    if (declare_) {
+        return;
+    }
+
     for (const auto *it : declarators_) {
         it->Compile(pg);
     }
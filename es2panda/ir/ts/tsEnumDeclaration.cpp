@@ -16,6 +16,9 @@
 #include "tsEnumDeclaration.h"
 
 #include <binder/scope.h>
+#include <compiler/base/constantFolding.h>
+#include <compiler/base/lreference.h>
+#include <compiler/core/pandagen.h>
 #include <util/helpers.h>
 #include <ir/astDump.h>
 #include <ir/expressions/identifier.h>
@@ -28,6 +31,9 @@
 #include <ir/ts/tsEnumMember.h>
 #include <typescript/checker.h>
 
+#include <optional>
+#include <unordered_set>
+
 namespace panda::es2panda::ir {
 
 void TSEnumDeclaration::Iterate(const NodeTraverser &cb) const
@@ -44,7 +50,115 @@ void TSEnumDeclaration::Dump(ir::AstDumper *dumper) const
     dumper->Add({{"type", "TSEnumDeclaration"}, {"id", key_}, {"members", members_}, {"const", isConst_}});
 }
 
-void TSEnumDeclaration::Compile([[maybe_unused]] compiler::PandaGen *pg) const {}
+using StringMembers = std::unordered_set<util::StringView>;
+
+static bool IsStringMemberReference(const StringMembers &stringMembers, const util::StringView &enumName,
+                                    const ir::Expression *expr)
+{
+    if (expr->IsIdentifier()) {
+        return stringMembers.find(expr->AsIdentifier()->Name()) != stringMembers.end();
+    }
+
+    if (!expr->IsMemberExpression()) {
+        return false;
+    }
+
+    const auto *member = expr->AsMemberExpression();
+
+    if (!member->Object()->IsIdentifier() || member->Object()->AsIdentifier()->Name() != enumName) {
+        return false;
+    }
+
+    const ir::Expression *prop = member->Property();
+
+    if (!member->IsComputed()) {
+        return prop->IsIdentifier() && stringMembers.find(prop->AsIdentifier()->Name()) != stringMembers.end();
+    }
+
+    return prop->IsStringLiteral() && stringMembers.find(prop->AsStringLiteral()->Str()) != stringMembers.end();
+}
+
+// Returns true if the initializer is a constant string expression, such members get no reverse mapping
+static bool IsStringInitializer(const StringMembers &stringMembers, const util::StringView &enumName,
+                                const ir::Expression *init)
+{
+    if (compiler::ConstantFolding::IsStringConstant(init) || IsStringMemberReference(stringMembers, enumName, init)) {
+        return true;
+    }
+
+    if (init->IsBinaryExpression() && init->AsBinaryExpression()->OperatorType() == lexer::TokenType::PUNCTUATOR_PLUS) {
+        const auto *binary = init->AsBinaryExpression();
+        return IsStringInitializer(stringMembers, enumName, binary->Left()) ||
+               IsStringInitializer(stringMembers, enumName, binary->Right());
+    }
+
+    return false;
+}
+
+void TSEnumDeclaration::Compile(compiler::PandaGen *pg) const
+{
+    compiler::RegScope rs(pg);
+    compiler::VReg enumObj = pg->AllocReg();
+    compiler::VReg value = pg->AllocReg();
+    auto *initialized = pg->AllocLabel();
+
+    /* E = E || {}, declarations of the same enum fill one object */
+    auto lref = compiler::LReference::CreateLRef(pg, key_, false);
+    lref.GetValue();
+    pg->StoreAccumulator(this, enumObj);
+    pg->ToBoolean(this);
+    pg->BranchIfTrue(this, initialized);
+    pg->CreateEmptyObject(this);
+    pg->StoreAccumulator(this, enumObj);
+    lref.SetValue();
+    pg->SetLabel(this, initialized);
+
+    /* The initializers are compiled in the scope of the enum, where members are read from the enum object */
+    compiler::LocalRegScope enumScope(pg, scope_);
+    StringMembers stringMembers;
+    const TSEnumMember *prev = nullptr;
+    std::optional<double> prevValue;
+
+    for (const auto *member : members_) {
+        const ir::Expression *init = member->Init();
+        bool isString = false;
+
+        if (init != nullptr) {
+            isString = IsStringInitializer(stringMembers, key_->Name(), init);
+            init->Compile(pg);
+
+            const ir::Literal *folded = compiler::ConstantFolding::TryFoldLiteral(pg, init);
+            prevValue = folded != nullptr && folded->IsNumberLiteral()
+                            ? std::optional<double>(folded->AsNumberLiteral()->Number())
+                            : std::nullopt;
+        } else if (prev == nullptr || prevValue.has_value()) {
+            prevValue = prev == nullptr ? 0 : *prevValue + 1;
+
+            auto *number = pg->Allocator()->New<ir::NumberLiteral>(*prevValue);
+            number->SetRange(member->Range());
+            number->Compile(pg);
+        } else {
+            /* The previous member is only known at runtime, E.B = E.A + 1 */
+            pg->LoadObjByName(member, enumObj, prev->Name());
+            pg->StoreAccumulator(member, value);
+            pg->LoadAccumulatorInt(member, 1);
+            pg->Binary(member, lexer::TokenType::PUNCTUATOR_PLUS, value);
+        }
+
+        /* E["A"] = value, numeric members also get the reverse mapping E[value] = "A" */
+        pg->StoreAccumulator(member, value);
+        pg->StoreObjByName(member, enumObj, member->Name());
+
+        if (isString) {
+            stringMembers.insert(member->Name());
+        } else {
+            pg->LoadAccumulatorString(member, member->Name());
+            pg->StoreObjByValue(member, enumObj, value);
+        }
+
+        prev = member;
+    }
+}
 
 int32_t ToInt(double num)
 {
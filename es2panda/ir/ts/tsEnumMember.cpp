@@ -17,6 +17,8 @@
 
 #include <ir/astDump.h>
 #include <ir/expression.h>
+#include <ir/expressions/identifier.h>
+#include <ir/expressions/literals/stringLiteral.h>
 
 namespace panda::es2panda::ir {
 
@@ -29,6 +31,15 @@ void TSEnumMember::Iterate(const NodeTraverser &cb) const
     }
 }
 
+const util::StringView &TSEnumMember::Name() const
+{
+    if (key_->IsIdentifier()) {
+        return key_->AsIdentifier()->Name();
+    }
+
+    return key_->AsStringLiteral()->Str();
+}
+
 void TSEnumMember::Dump(ir::AstDumper *dumper) const
 {
     dumper->Add({{"type", "TSEnumMember"}, {"id", key_}, {"initializer", AstDumper::Optional(init_)}});
@@ -47,6 +47,9 @@ public:
     {
         return init_;
     }
+
+    const util::StringView &Name() const;
+
     void Iterate(const NodeTraverser &cb) const override;
     void Dump(ir::AstDumper *dumper) const override;
     void Compile([[maybe_unused]] compiler::PandaGen *pg) const override;
@@ -15,9 +15,16 @@
 
 #include "tsImportEqualsDeclaration.h"
 
+#include <binder/scope.h>
+#include <binder/variable.h>
+#include <compiler/base/lreference.h>
+#include <compiler/core/pandagen.h>
 #include <ir/astDump.h>
 #include <ir/expression.h>
 #include <ir/expressions/identifier.h>
+#include <ir/ts/tsModuleDeclaration.h>
+#include <ir/ts/tsQualifiedName.h>
+#include <typescript/checker.h>
 
 namespace panda::es2panda::ir {
 
@@ -35,10 +42,43 @@ void TSImportEqualsDeclaration::Dump(ir::AstDumper *dumper) const
                  {"isExport", isExport_}});
 }
 
-void TSImportEqualsDeclaration::Compile([[maybe_unused]] compiler::PandaGen *pg) const {}
+void TSImportEqualsDeclaration::Compile(compiler::PandaGen *pg) const
+{
+    // import x = require("m") needs a CommonJS loader, which the runtime does not provide
+    if (moduleReference_->IsTSExternalModuleReference()) {
+        compiler::PandaGen::Unimplemented();
+    }
+
+    const Expression *root = moduleReference_;
+
+    while (root->IsTSQualifiedName()) {
+        root = root->AsTSQualifiedName()->Left();
+    }
+
+    /* Aliases into namespaces holding only types are erased */
+    const binder::Variable *rootVar = pg->Scope()->Find(root->AsIdentifier()->Name()).variable;
+
+    if (rootVar != nullptr && rootVar->Declaration()->Node() != nullptr &&
+        rootVar->Declaration()->Node()->IsTSModuleDeclaration() &&
+        !rootVar->Declaration()->Node()->AsTSModuleDeclaration()->IsInstantiated()) {
+        return;
+    }
+
+    /* import x = N.y binds x like const x = N.y */
+    auto lref = compiler::LReference::CreateLRef(pg, id_, true);
+    moduleReference_->Compile(pg);
+    lref.SetValue();
+}
 
 checker::Type *TSImportEqualsDeclaration::Check([[maybe_unused]] checker::Checker *checker) const
 {
+    // Aliases are not resolved by the checker yet, their uses are typed as any
+    binder::Variable *alias = checker->Scope()->FindLocal(id_->Name());
+
+    if (alias != nullptr && alias->TsType() == nullptr) {
+        alias->SetTsType(checker->GlobalAnyType());
+    }
+
     return nullptr;
 }
 
@@ -61,7 +61,7 @@ void CheckInheritedPropertiesAreIdentical(checker::Checker *checker, checker::In
         return;
     }
 
-    checker::InterfacePropertyMap properties;
+    checker::InterfacePropertyMap properties(checker->Allocator()->Adapter());
 
     for (auto *it : type->Properties()) {
         properties.insert({it->Name(), {it, type}});
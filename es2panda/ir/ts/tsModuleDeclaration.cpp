@@ -16,8 +16,24 @@
 #include "tsModuleDeclaration.h"
 
 #include <binder/scope.h>
+#include <compiler/base/lreference.h>
+#include <compiler/core/pandagen.h>
 #include <ir/astDump.h>
+#include <ir/base/classDefinition.h>
+#include <ir/base/scriptFunction.h>
 #include <ir/expression.h>
+#include <ir/expressions/identifier.h>
+#include <ir/module/exportNamedDeclaration.h>
+#include <ir/statements/classDeclaration.h>
+#include <ir/statements/functionDeclaration.h>
+#include <ir/statements/variableDeclaration.h>
+#include <ir/statements/variableDeclarator.h>
+#include <ir/ts/tsEnumDeclaration.h>
+#include <ir/ts/tsImportEqualsDeclaration.h>
+#include <ir/ts/tsModuleBlock.h>
+#include <util/helpers.h>
+
+#include <vector>
 
 namespace panda::es2panda::ir {
 
@@ -39,7 +55,180 @@ void TSModuleDeclaration::Dump(ir::AstDumper *dumper) const
                  {"global", global_}});
 }
 
-void TSModuleDeclaration::Compile([[maybe_unused]] compiler::PandaGen *pg) const {}
+static bool IsTypeOnlyStatement(const Statement *stmt)
+{
+    if (stmt->IsExportNamedDeclaration()) {
+        stmt = stmt->AsExportNamedDeclaration()->Decl();
+
+        if (stmt == nullptr) {
+            return false;
+        }
+    }
+
+    if (stmt->IsTSModuleDeclaration()) {
+        return !stmt->AsTSModuleDeclaration()->IsInstantiated();
+    }
+
+    return stmt->IsTSInterfaceDeclaration() || stmt->IsTSTypeAliasDeclaration();
+}
+
+bool TSModuleDeclaration::IsInstantiated() const
+{
+    if (declare_ || body_ == nullptr) {
+        return false;
+    }
+
+    if (body_->IsTSModuleDeclaration()) {
+        return body_->AsTSModuleDeclaration()->IsInstantiated();
+    }
+
+    for (const auto *stmt : body_->AsTSModuleBlock()->Statements()) {
+        if (!IsTypeOnlyStatement(stmt)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Names of the values declared by a statement exported from a namespace
+static std::vector<const Identifier *> ExportedNames(const Statement *decl)
+{
+    std::vector<const Identifier *> names;
+
+    switch (decl->Type()) {
+        case AstNodeType::VARIABLE_DECLARATION: {
+            if (decl->AsVariableDeclaration()->Declare()) {
+                break;
+            }
+
+            for (const auto *declarator : decl->AsVariableDeclaration()->Declarators()) {
+                auto bindings = util::Helpers::CollectBindingNames(declarator->Id());
+                names.insert(names.end(), bindings.begin(), bindings.end());
+            }
+
+            break;
+        }
+        case AstNodeType::FUNCTION_DECLARATION: {
+            const ScriptFunction *func = decl->AsFunctionDeclaration()->Function();
+
+            if (!func->IsOverload() && !func->Declare()) {
+                names.push_back(func->Id());
+            }
+
+            break;
+        }
+        case AstNodeType::CLASS_DECLARATION: {
+            if (!decl->AsClassDeclaration()->Definition()->Declare()) {
+                names.push_back(decl->AsClassDeclaration()->Definition()->Ident());
+            }
+
+            break;
+        }
+        case AstNodeType::TS_ENUM_DECLARATION: {
+            names.push_back(decl->AsTSEnumDeclaration()->Key());
+            break;
+        }
+        case AstNodeType::TS_MODULE_DECLARATION: {
+            if (decl->AsTSModuleDeclaration()->IsInstantiated()) {
+                names.push_back(decl->AsTSModuleDeclaration()->Name()->AsIdentifier());
+            }
+
+            break;
+        }
+        case AstNodeType::TS_IMPORT_EQUALS_DECLARATION: {
+            names.push_back(decl->AsTSImportEqualsDeclaration()->Id());
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+
+    return names;
+}
+
+static void StoreExportedNames(compiler::PandaGen *pg, compiler::VReg moduleObj, const Statement *decl)
+{
+    for (const auto *name : ExportedNames(decl)) {
+        name->Compile(pg);
+        pg->StoreObjByName(name, moduleObj, name->Name());
+    }
+}
+
+static void CompileExportedDeclaration(compiler::PandaGen *pg, compiler::VReg moduleObj, const Statement *decl)
+{
+    /* Exported enums and namespaces continue the object stored on the namespace, N.E || (N.E = {}) */
+    if (decl->IsTSEnumDeclaration() || decl->IsTSModuleDeclaration()) {
+        for (const auto *name : ExportedNames(decl)) {
+            auto lref = compiler::LReference::CreateLRef(pg, name, false);
+            pg->LoadObjByName(name, moduleObj, name->Name());
+            lref.SetValue();
+        }
+    }
+
+    decl->Compile(pg);
+
+    /* Functions are hoisted, they are stored on the namespace before the body runs */
+    if (!decl->IsFunctionDeclaration()) {
+        StoreExportedNames(pg, moduleObj, decl);
+    }
+}
+
+static void CompileModuleBlock(compiler::PandaGen *pg, compiler::VReg moduleObj, const TSModuleBlock *block)
+{
+    compiler::LocalRegScope blockScope(pg, block->Scope());
+
+    for (const auto *stmt : block->Statements()) {
+        if (stmt->IsExportNamedDeclaration() && stmt->AsExportNamedDeclaration()->Decl() != nullptr &&
+            stmt->AsExportNamedDeclaration()->Decl()->IsFunctionDeclaration()) {
+            StoreExportedNames(pg, moduleObj, stmt->AsExportNamedDeclaration()->Decl());
+        }
+    }
+
+    for (const auto *stmt : block->Statements()) {
+        if (stmt->IsExportNamedDeclaration() && stmt->AsExportNamedDeclaration()->Decl() != nullptr) {
+            CompileExportedDeclaration(pg, moduleObj, stmt->AsExportNamedDeclaration()->Decl());
+        } else if (stmt->IsTSImportEqualsDeclaration() && stmt->AsTSImportEqualsDeclaration()->IsExport()) {
+            CompileExportedDeclaration(pg, moduleObj, stmt);
+        } else {
+            stmt->Compile(pg);
+        }
+    }
+}
+
+void TSModuleDeclaration::Compile(compiler::PandaGen *pg) const
+{
+    // Namespaces holding only types are erased
+    if (!IsInstantiated()) {
+        return;
+    }
+
+    compiler::RegScope rs(pg);
+    compiler::VReg moduleObj = pg->AllocReg();
+    auto *initialized = pg->AllocLabel();
+
+    /* N = N || {}, declarations of the same namespace fill one object */
+    auto lref = compiler::LReference::CreateLRef(pg, name_, false);
+    lref.GetValue();
+    pg->StoreAccumulator(this, moduleObj);
+    pg->ToBoolean(this);
+    pg->BranchIfTrue(this, initialized);
+    pg->CreateEmptyObject(this);
+    pg->StoreAccumulator(this, moduleObj);
+    lref.SetValue();
+    pg->SetLabel(this, initialized);
+
+    compiler::LocalRegScope moduleScope(pg, scope_);
+
+    /* namespace A.B {} declares B as an exported namespace of A */
+    if (body_->IsTSModuleDeclaration()) {
+        CompileExportedDeclaration(pg, moduleObj, body_);
+        return;
+    }
+
+    CompileModuleBlock(pg, moduleObj, body_->AsTSModuleBlock());
+}
 
 checker::Type *TSModuleDeclaration::Check([[maybe_unused]] checker::Checker *checker) const
 {
@@ -73,6 +73,9 @@ public:
         return global_;
     }
 
+    // Returns true if the namespace declares values, namespaces holding only types are erased
+    bool IsInstantiated() const;
+
     void Iterate(const NodeTraverser &cb) const override;
     void Dump(ir::AstDumper *dumper) const override;
     void Compile([[maybe_unused]] compiler::PandaGen *pg) const override;
@@ -29,7 +29,10 @@ void TSNonNullExpression::Dump(ir::AstDumper *dumper) const
     dumper->Add({{"type", "TSNonNullExpression"}, {"expression", expr_}});
 }
 
-void TSNonNullExpression::Compile([[maybe_unused]] compiler::PandaGen *pg) const {}
+void TSNonNullExpression::Compile(compiler::PandaGen *pg) const
+{
+    expr_->Compile(pg);
+}
 
 checker::Type *TSNonNullExpression::Check([[maybe_unused]] checker::Checker *checker) const
 {
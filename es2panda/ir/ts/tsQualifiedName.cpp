@@ -15,6 +15,7 @@
 
 #include "tsQualifiedName.h"
 
+#include <compiler/core/pandagen.h>
 #include <typescript/checker.h>
 #include <ir/astDump.h>
 #include <ir/expressions/identifier.h>
@@ -32,7 +33,16 @@ void TSQualifiedName::Dump(ir::AstDumper *dumper) const
     dumper->Add({{"type", "TSQualifiedName"}, {"left", left_}, {"right", right_}});
 }
 
-void TSQualifiedName::Compile([[maybe_unused]] compiler::PandaGen *pg) const {}
+void TSQualifiedName::Compile(compiler::PandaGen *pg) const
+{
+    // Only entity names of import aliases are compiled, N.y reads y of the namespace object
+    compiler::RegScope rs(pg);
+    compiler::VReg obj = pg->AllocReg();
+
+    left_->Compile(pg);
+    pg->StoreAccumulator(this, obj);
+    pg->LoadObjByName(this, obj, right_->Name());
+}
 
 checker::Type *TSQualifiedName::Check([[maybe_unused]] checker::Checker *checker) const
 {
@@ -30,7 +30,10 @@ void TSTypeAssertion::Dump(ir::AstDumper *dumper) const
     dumper->Add({{"type", "TSTypeAssertion"}, {"typeAnnotation", typeAnnotation_}, {"expression", expression_}});
 }
 
-void TSTypeAssertion::Compile([[maybe_unused]] compiler::PandaGen *pg) const {}
+void TSTypeAssertion::Compile(compiler::PandaGen *pg) const
+{
+    expression_->Compile(pg);
+}
 
 checker::Type *TSTypeAssertion::Check([[maybe_unused]] checker::Checker *checker) const
 {
@@ -23,14 +23,15 @@
 
 namespace panda::es2panda::lexer {
 
+// The values are the flag bits expected by the runtime in ecma.createregexpwithliteral
 enum class RegExpFlags {
     EMPTY = 0,
     GLOBAL = 1 << 0,
     IGNORE_CASE = 1 << 1,
     MULTILINE = 1 << 2,
-    STICKY = 1 << 3,
+    DOTALL = 1 << 3,
     UNICODE = 1 << 4,
-    DOTALL = 1 << 5,
+    STICKY = 1 << 5,
 };
 
 DEFINE_BITOPS(RegExpFlags)
@@ -1026,7 +1026,7 @@ ir::Expression *ParserImpl::ParsePrimaryExpression(ExpressionParseFlags flags)
                 ThrowSyntaxError(e.message.c_str());
             }
 
-            auto *regexpNode = AllocNode<ir::RegExpLiteral>(regexp.patternStr, regexp.flagsStr);
+            auto *regexpNode = AllocNode<ir::RegExpLiteral>(regexp.patternStr, regexp.flags, regexp.flagsStr);
             regexpNode->SetRange(lexer_->GetToken().Loc());
 
             lexer_->NextToken();
@@ -2544,8 +2544,8 @@ ir::ClassDefinition *ParserImpl::ParseClassDefinition(bool isDeclaration, bool i
     return classDefinition;
 }
 
-ir::TSEnumDeclaration *ParserImpl::ParseEnumMembers(ir::Identifier *key, const lexer::SourcePosition &enumStart,
-                                                    bool isConst)
+ir::TSEnumDeclaration *ParserImpl::ParseEnumMembers(ir::Identifier *key, binder::VarDecl *objectDecl,
+                                                    const lexer::SourcePosition &enumStart, bool isConst)
 {
     if (lexer_->GetToken().Type() != lexer::TokenType::PUNCTUATOR_LEFT_BRACE) {
         ThrowSyntaxError("'{' expected");
@@ -2596,6 +2596,7 @@ ir::TSEnumDeclaration *ParserImpl::ParseEnumMembers(ir::Identifier *key, const l
         AllocNode<ir::TSEnumDeclaration>(Binder()->GetScope()->AsLocalScope(), key, std::move(members), isConst);
     enumDeclaration->SetRange({enumStart, lexer_->GetToken().End()});
     Binder()->GetScope()->BindNode(enumDeclaration);
+    objectDecl->BindNode(enumDeclaration);
     lexer_->NextToken();  // eat '}'
 
     return enumDeclaration;
@@ -2616,6 +2617,10 @@ ir::TSEnumDeclaration *ParserImpl::ParseEnumDeclaration(bool isConst)
 
     auto *key = AllocNode<ir::Identifier>(ident, Allocator());
     key->SetRange(lexer_->GetToken().Loc());
+    key->SetReference();
+
+    // The enum object is held by a var, declarations of the same enum share it
+    auto *objectDecl = Binder()->AddDecl<binder::VarDecl>(lexer_->GetToken().Start(), ident);
     lexer_->NextToken();
 
     const auto &bindings = Binder()->GetScope()->Bindings();
@@ -2626,7 +2631,7 @@ ir::TSEnumDeclaration *ParserImpl::ParseEnumDeclaration(bool isConst)
         decl = Binder()->AddTsDecl<binder::EnumLiteralDecl>(lexer_->GetToken().Start(), tsBinding.View(), isConst);
         binder::LexicalScope enumCtx = binder::LexicalScope<binder::LocalScope>(Binder());
         decl->AsEnumLiteralDecl()->BindScope(enumCtx.GetScope());
-        return ParseEnumMembers(key, enumStart, isConst);
+        return ParseEnumMembers(key, objectDecl, enumStart, isConst);
     }
 
     if (!res->second->Declaration()->IsEnumLiteralDecl() ||
@@ -2637,7 +2642,7 @@ ir::TSEnumDeclaration *ParserImpl::ParseEnumDeclaration(bool isConst)
     decl = res->second->Declaration()->AsEnumLiteralDecl();
 
     auto scopeCtx = binder::LexicalScope<binder::LocalScope>::Enter(Binder(), decl->Scope());
-    return ParseEnumMembers(key, enumStart, isConst);
+    return ParseEnumMembers(key, objectDecl, enumStart, isConst);
 }
 
 void ParserImpl::ValidateFunctionParam(const ArenaVector<ir::Expression *> &params, const ir::Expression *parameter,
@@ -3252,7 +3257,8 @@ ScriptExtension ParserImpl::Extension() const
 
 void ExportDeclarationContext::BindExportDecl(const ir::AstNode *exportDecl)
 {
-    if (!binder_) {
+    // Members exported by a namespace are stored on the namespace object instead
+    if (!binder_ || !binder_->GetScope()->IsModuleScope()) {
         return;
     }
 
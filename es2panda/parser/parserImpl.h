@@ -439,7 +439,8 @@ private:
     ir::ClassDeclaration *ParseClassDeclaration(bool idRequired, ArenaVector<ir::Decorator *> &&decorators,
                                                 bool isDeclare = false, bool isAbstract = false);
     ir::TSTypeAliasDeclaration *ParseTsTypeAliasDeclaration(bool isDeclare);
-    ir::TSEnumDeclaration *ParseEnumMembers(ir::Identifier *key, const lexer::SourcePosition &enumStart, bool isConst);
+    ir::TSEnumDeclaration *ParseEnumMembers(ir::Identifier *key, binder::VarDecl *objectDecl,
+                                            const lexer::SourcePosition &enumStart, bool isConst);
     ir::TSEnumDeclaration *ParseEnumDeclaration(bool isConst = false);
     ir::TSInterfaceDeclaration *ParseTsInterfaceDeclaration();
     ir::SwitchCaseStatement *ParseSwitchCaseStatement(bool *seenDefault);
@@ -17,6 +17,7 @@
 
 #include <binder/binder.h>
 #include <ir/astDump.h>
+#include <ir/astSnapshot.h>
 
 namespace panda::es2panda::parser {
 
@@ -69,4 +70,26 @@ std::string Program::Dump() const
     return dumper.Str();
 }
 
+void Program::Dump(std::ostream &out) const
+{
+    ir::AstDumper dumper {ast_, SourceCode(), out};
+}
+
+std::string Program::DumpSnapshot() const
+{
+    return ir::AstSnapshot::Save(ast_);
+}
+
+bool Program::DumpFromSnapshot(std::string_view snapshot, std::ostream &out) const
+{
+    const auto *root = ir::AstSnapshot::Load(allocator_.get(), snapshot);
+
+    if (root == nullptr) {
+        return false;
+    }
+
+    ir::AstSnapshot::Dump(root, SourceCode(), out);
+    return true;
+}
+
 }  // namespace panda::es2panda::parser
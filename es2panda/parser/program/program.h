@@ -22,6 +22,9 @@
 
 #include "es2panda.h"
 
+#include <ostream>
+#include <string_view>
+
 namespace panda::es2panda::ir {
 class BlockStatement;
 }  // namespace panda::es2panda::ir
@@ -99,6 +102,11 @@ public:
     }
 
     std::string Dump() const;
+    void Dump(std::ostream &out) const;
+    // Binary form of the tree Dump prints, see ir::AstSnapshot
+    std::string DumpSnapshot() const;
+    // Prints the tree loaded back from a snapshot of this program, returns false if it is not a snapshot
+    bool DumpFromSnapshot(std::string_view snapshot, std::ostream &out) const;
     void SetKind(ScriptKind kind);
 
 private:
@@ -336,6 +336,7 @@ ir::TSImportEqualsDeclaration *ParserImpl::ParseTsImportEqualsDeclaration(const
 
     auto *id = AllocNode<ir::Identifier>(lexer_->GetToken().Ident(), Allocator());
     id->SetRange(lexer_->GetToken().Loc());
+    Binder()->AddDecl<binder::ConstDecl>(id->Start(), id->Name());
     lexer_->NextToken();  // eat id name
 
     if (lexer_->GetToken().Type() != lexer::TokenType::PUNCTUATOR_SUBSTITUTION) {
@@ -2286,6 +2287,7 @@ ir::Expression *ParserImpl::ParseModuleReference()
     } else {
         result = AllocNode<ir::Identifier>(lexer_->GetToken().Ident(), Allocator());
         result->SetRange(lexer_->GetToken().Loc());
+        result->AsIdentifier()->SetReference();
         lexer_->NextToken();
 
         if (lexer_->GetToken().Type() == lexer::TokenType::PUNCTUATOR_PERIOD) {
@@ -2307,6 +2309,7 @@ ir::AstNode *ParserImpl::ParseImportDefaultSpecifier(ArenaVector<ir::AstNode *>
             ThrowSyntaxError("identifier expected");
         }
 
+        Binder()->AddDecl<binder::ConstDecl>(local->Start(), local->Name());
         auto *importEqualsDecl = AllocNode<ir::TSImportEqualsDeclaration>(local, ParseModuleReference(), false);
 
         return importEqualsDecl;
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+function typedDeclarations(limit: number) {
+    let count: number = limit > 0 ? limit : 0;
+    const name: string = "typed_name";
+    let flag: boolean = count > 1;
+    let nothing: undefined = undefined;
+    let anything: any = name;
+    let list: number[] = [count];
+    return [count, name, flag, nothing, anything, list];
+}
+
+typedDeclarations(2);
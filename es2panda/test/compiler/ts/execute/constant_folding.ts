@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Negative zero
+print(1 / -0);
+print(1 / (0 * -1));
+print(1 / (-0 + 0));
+print(1 / (-1 % 1));
+print("z" + -0);
+
+// Infinities
+print(1 / 0);
+print(-1 / 0);
+print(2 ** 1024);
+print("x" + 1 / 0);
+print("x" + -1 / 0);
+print((1 / 0) >>> 0);
+
+// NaN
+print(0 / 0);
+print("x" + 0 / 0);
+print((0 / 0) === (0 / 0));
+print((0 / 0) !== (0 / 0));
+print((0 / 0) | 0);
+print(1 ** (1 / 0));
+print((0 / 0) ** 0);
+print(void 0 + 1);
+
+// Integer number to string
+print("n" + 42);
+print("n" + -7);
+print(`t${3}${-3}`);
+print(-1 >>> 0);
+print("n" + (-1 >>> 0));
+print((2 ** 32 + 5) | 0);
+
+// Non-integer number to string is left to the runtime
+print("n" + 0.5);
+print("n" + 0.1 * 3);
+print("n" + 1e21);
+print(`t${3}${0.25}`);
+print(5.5 % 2);
+
+// String to number is left to the runtime
+print("3" * "4");
+print(" 12 " - 2);
+print("0x10" - 0);
+print("1e3" / 10);
+print("" - 1);
+print("abc" * 1);
+print(+"  ");
+print("2" > "10");
+print("2" > 10);
+
+// Other primitives
+print(null + 1);
+print(true + true);
+print(null + "x");
+print(typeof null);
+print(typeof "a");
+print(void 0 ?? "d");
+print(0 || "y");
+print(1 && "z");
+
+// Only the taken branch is compiled
+let hits = 0;
+function hit(v) {
+    hits++;
+    return v;
+}
+
+print(true ? hit("a") : hit("b"));
+print(0 ? hit("a") : hit("b"));
+print("" ? hit("a") : hit("b"));
+print((0 / 0) ? hit("a") : hit("b"));
+print(-0 ? hit("a") : hit("b"));
+print("0" ? hit("a") : hit("b"));
+print(1 - 1 ? hit("a") : 2 > 1 ? hit("c") : hit("d"));
+print(hits);
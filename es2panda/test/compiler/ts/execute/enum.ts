@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+enum Color {
+    Red,
+    Green = 5,
+    Blue,
+}
+
+print(Color.Red);
+print(Color.Green);
+print(Color.Blue);
+print(Color[5]);
+
+enum Color {
+    Black = 10,
+}
+
+print(Color.Black);
+print(Color[0]);
+
+enum Str {
+    A = "a",
+    B = A + "b",
+    C = `c`,
+}
+
+print(Str.B);
+print(Str.C);
+print(Str["ab"]);
+
+enum Computed {
+    X = "abc".length,
+    Y,
+    Z = X * Y,
+}
+
+print(Computed.Y);
+print(Computed[3]);
+print(Computed.Z);
+
+function local(): number {
+    enum Local {
+        P = 2,
+        Q = P * 2,
+    }
+
+    return Local.Q;
+}
+
+print(local());
+
+const enum Flags {
+    None = 0,
+    Read = 1 << 0,
+    Write = 1 << 1,
+    All = Read | Write,
+}
+
+print(Flags.All);
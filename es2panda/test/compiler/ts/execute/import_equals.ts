@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Config {
+    export namespace Defaults {
+        export const port = 8080;
+    }
+
+    export const name = "config";
+
+    export interface Options {
+        verbose: boolean;
+    }
+}
+
+import Defaults = Config.Defaults;
+import name = Config.name;
+import Options = Config.Options;
+
+print(Defaults.port);
+print(name);
+
+namespace Server {
+    export import port = Config.Defaults.port;
+    import local = Config.name;
+
+    print(local);
+}
+
+print(Server.port);
+
+function read(): number {
+    return Defaults.port + 1;
+}
+
+print(read());
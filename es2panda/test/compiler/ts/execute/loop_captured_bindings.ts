@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+function callAll(fns) {
+    return fns.map(f => f()).join();
+}
+
+// Only the loop variable is captured
+let simple = [];
+for (let i = 0; i < 3; i++) {
+    simple.push(() => i);
+}
+print(callAll(simple));
+
+// The enclosing function captures a binding too, and the update creates a closure
+let c = 10;
+const getC = () => c;
+let updated = [];
+for (let i = 0; i < 3; i = (() => i + 1)()) {
+    updated.push(() => i + getC());
+}
+print(callAll(updated));
+
+// The test creates a closure
+let tested = [];
+for (let i = 0; (() => i < 3)(); i++) {
+    tested.push(() => i);
+}
+print(callAll(tested));
+
+// A binding of the body is captured as well
+let withBody = [];
+for (let i = 0; i < 2; i++) {
+    let k = i * 2;
+    withBody.push(() => i + k);
+}
+print(callAll(withBody));
+
+// Nested loops
+let nested = [];
+for (let i = 0; i < 2; i++) {
+    for (let j = 0; j < 2; j++) {
+        nested.push(() => i * 10 + j);
+    }
+}
+print(callAll(nested));
+
+// for-of
+let forOf = [];
+for (const v of ["a", "b"]) {
+    forOf.push(() => v);
+}
+print(callAll(forOf));
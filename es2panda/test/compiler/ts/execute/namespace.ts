@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Geometry {
+    const hidden = 3;
+    export const unit = 2;
+
+    export function area(side: number): number {
+        return side * side * unit;
+    }
+
+    export class Point {
+        constructor(public x: number) {}
+    }
+
+    export enum Kind {
+        Line,
+        Square,
+    }
+
+    export namespace Inner {
+        export const depth = hidden + unit;
+    }
+
+    print(area(1));
+}
+
+print(Geometry.unit);
+print(Geometry.area(3));
+print(new Geometry.Point(4).x);
+print(Geometry.Kind.Square);
+print(Geometry.Inner.depth);
+print(Geometry["hidden"]);
+
+namespace Geometry {
+    export const extra = Geometry.unit + 1;
+}
+
+print(Geometry.extra);
+print(Geometry.unit);
+
+namespace A.B.C {
+    export const deep = "deep";
+}
+
+print(A.B.C.deep);
+
+namespace Types {
+    export interface Shape {
+        sides: number;
+    }
+}
+
+print(typeof Types);
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+function describe(re) {
+    return [re.source, re.flags, re.global, re.ignoreCase, re.multiline, re.dotAll, re.unicode, re.sticky].join(" ");
+}
+
+// Each flag alone
+print(describe(/a/));
+print(describe(/a/g));
+print(describe(/a/i));
+print(describe(/a/m));
+print(describe(/a/s));
+print(describe(/a/u));
+print(describe(/a/y));
+
+// Combinations, flags are reported in canonical order whatever the source order
+print(describe(/a/gi));
+print(describe(/a/yg));
+print(describe(/a/msi));
+print(describe(/a/uy));
+print(describe(/a/yusmig));
+
+// The flags change matching
+print("aAa".match(/a/g).length);
+print("aAa".match(/a/gi).length);
+print(/^b/.test("a\nb"));
+print(/^b/m.test("a\nb"));
+print(/a.b/.test("a\nb"));
+print(/a.b/s.test("a\nb"));
+print(/^.$/.test("\u{1F600}"));
+print(/^.$/u.test("\u{1F600}"));
+
+let sticky = /a/y;
+sticky.lastIndex = 1;
+print(sticky.test("ba"));
+sticky.lastIndex = 0;
+print(sticky.test("ba"));
+
+let globalRe = /o/g;
+globalRe.test("foo");
+print(globalRe.lastIndex);
+
+// Every evaluation of a literal creates a new object
+function create() {
+    return /x/gimsuy;
+}
+let first = create();
+let second = create();
+first.lastIndex = 3;
+print([first !== second, second.lastIndex, second.flags].join(" "));
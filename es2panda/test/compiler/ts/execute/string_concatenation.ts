@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+let log = [];
+
+function obj(name, value) {
+    return {
+        valueOf() {
+            log.push(name + ".valueOf");
+            return value;
+        },
+        toString() {
+            log.push(name + ".toString");
+            return name;
+        }
+    };
+}
+
+// Template literals convert with toString, so the operands only define that
+function str(name) {
+    return {
+        toString() {
+            log.push(name + ".toString");
+            return name;
+        }
+    };
+}
+
+function f(result) {
+    log.push("f");
+    return result;
+}
+
+function check(label, result) {
+    print(label + ": " + result + " | " + log.join(","));
+    log = [];
+}
+
+let x = obj("x", 1);
+let y = obj("y", 2);
+let a = obj("a", "A");
+
+check("x + \"a\" + f()", x + "a" + f(y));
+check("\"s\" + x + f()", "s" + x + f(y));
+check("\"s\" + (a + \"b\" + f())", "s" + (a + "b" + f(x)));
+check("\"s\" + (x + y + f())", "s" + (x + y + f(a)));
+check("x + \"\" + y", x + "" + y);
+check("x + y + \"\"", x + y + "");
+check("x + (\"\" + y)", x + ("" + y));
+check("1 + 2 + x", 1 + 2 + x);
+check("1 + 2 + x + \"s\"", 1 + 2 + x + "s");
+check("1 + 2 + \"s\" + x", 1 + 2 + "s" + x);
+check("\"s\" + 1 + 2 + x", "s" + 1 + 2 + x);
+check("x + 1 + \"s\" + f()", x + 1 + "s" + f(y));
+check("f() + \"\"", f(x) + "");
+
+let p = str("p");
+let q = str("q");
+check("${p}${q}", `${p}${q}`);
+check("${p}-${f()}", `${p}-${f(q)}`);
+check("${1 + 2}${p}", `${1 + 2}${p}`);
+check("\"s\" + `${p}` + q", "s" + `${p}` + q);
+check("`` + x", `` + x);
@@ -22,6 +22,7 @@ import fnmatch
 import multiprocessing
 import os
 import re
+import shutil
 import subprocess
 import sys
 import test262util
@@ -66,6 +67,9 @@ def get_args():
     parser.add_argument(
         '--tsc', action='store_true', dest='tsc',
         default=False, help='run tsc tests')
+    parser.add_argument(
+        '--compiler', '-c', action='store_true', dest='compiler',
+        default=False, help='run compiler tests')
     parser.add_argument(
         '--no-progress', action='store_false', dest='progress', default=True,
         help='don\'t show progress bar')
@@ -162,6 +166,14 @@ class Test:
         return self
 
 
+# Dumps the AST loaded back from its snapshot, which must print the same
+# output as the parsed AST
+class SnapshotTest(Test):
+    def __init__(self, test_path, flags, snapshot_path):
+        Test.__init__(self, test_path,
+                      flags + ['--dump-ast-snapshot=%s' % snapshot_path])
+
+
 class Test262Test(Test):
     def __init__(self, test_path, flags, test_id, with_optimizer):
         Test.__init__(self, test_path, flags)
@@ -313,6 +325,172 @@ class Test262Test(Test):
         return self
 
 
+class CompilerTest(Test):
+    def __init__(self, test_path, flags, test_id):
+        Test.__init__(self, test_path, flags)
+        self.test_id = test_id
+
+    def compile(self, runner, test_abc, source, extra_flags=None):
+        cmd = runner.cmd_prefix + [runner.es2panda, '--output=%s' % (test_abc)]
+        cmd.extend(self.flags)
+        cmd.extend(extra_flags or [])
+        cmd.append(source)
+
+        self.log_cmd(cmd)
+        process = subprocess.Popen(
+            cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, env=runner.cmd_env)
+
+        try:
+            out, err = process.communicate(timeout=runner.args.es2panda_timeout)
+        except subprocess.TimeoutExpired:
+            process.kill()
+            self.error = "ES2PANDA_TIMEOUT"
+            return False
+
+        self.output = out.decode("utf-8", errors="ignore")
+
+        if process.returncode != 0:
+            self.error = "out:{}\nerr:{}\ncode:{}".format(
+                out.decode("utf-8", errors="ignore"), err.decode("utf-8", errors="ignore"), process.returncode)
+            return False
+
+        return True
+
+    def execute(self, runner, test_abc, expected_path):
+        cmd = runner.cmd_prefix + [runner.runtime]
+        cmd.extend(runner.runtime_args)
+        cmd.extend(['--compiler-enable-jit=false', test_abc, "_GLOBAL::func_main_0"])
+
+        self.log_cmd(cmd)
+        process = subprocess.Popen(
+            cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, env=runner.cmd_env)
+
+        try:
+            out, err = process.communicate(timeout=runner.args.timeout)
+        except subprocess.TimeoutExpired:
+            process.kill()
+            self.passed = False
+            self.error = "RUNTIME_TIMEOUT"
+            return self
+
+        self.output = out.decode("utf-8", errors="ignore")
+
+        try:
+            with open(expected_path, 'r') as fp:
+                expected = fp.read()
+            self.passed = expected == self.output and process.returncode == 0
+        except Exception:
+            self.passed = False
+
+        if not self.passed:
+            self.error = "out:{}\nerr:{}\ncode:{}".format(
+                self.output, err.decode("utf-8", errors="ignore"), process.returncode)
+
+        return self
+
+    def run(self, runner):
+        test_abc = path.join(runner.tmp_dir, "%s.abc" % self.test_id)
+        os.makedirs(path.dirname(test_abc), exist_ok=True)
+
+        if not self.compile(runner, test_abc, self.path):
+            self.passed = False
+            return self
+
+        return self.execute(runner, test_abc, "%s-expected.txt" % (path.splitext(self.path)[0]))
+
+    # Each line of the checks file starting with '+' or '-' is text that the
+    # compiler output must or must not contain.
+    def check_output(self, checks_path):
+        failed_checks = []
+
+        with open(checks_path, 'r') as fp:
+            for line in fp:
+                line = line.rstrip("\n")
+
+                if line.startswith("+") and line[1:].strip() not in self.output:
+                    failed_checks.append(line)
+                elif line.startswith("-") and line[1:].strip() in self.output:
+                    failed_checks.append(line)
+
+        self.passed = len(failed_checks) == 0
+
+        if not self.passed:
+            self.error = "failed checks:\n{}\nout:{}".format(
+                "\n".join(failed_checks), self.output)
+
+        return self
+
+
+# Compiles the test without the function cache, then twice with it. The cold
+# build fills the cache and the warm build reads it, all outputs must be equal.
+class CacheTest(CompilerTest):
+    def __init__(self, test_path, flags, test_id):
+        CompilerTest.__init__(self, test_path, flags, test_id)
+
+    def run(self, runner):
+        test_dir = path.join(runner.tmp_dir, "%s-cache" % self.test_id)
+        shutil.rmtree(test_dir, ignore_errors=True)
+        os.makedirs(test_dir)
+
+        cache_flags = ['--cache-dir=%s' % path.join(test_dir, "cache")]
+        builds = [("uncached", []), ("cold", cache_flags), ("warm", cache_flags)]
+        outputs = []
+
+        for name, extra_flags in builds:
+            test_abc = path.join(test_dir, "%s.abc" % name)
+
+            if not self.compile(runner, test_abc, self.path, extra_flags):
+                self.passed = False
+                return self
+
+            with open(test_abc, 'rb') as fp:
+                outputs.append(fp.read())
+
+        mismatches = [name for (name, _), output in zip(builds, outputs) if output != outputs[0]]
+        self.passed = len(mismatches) == 0
+
+        if not self.passed:
+            self.error = "output of the %s build differs from the uncached one" % ", ".join(mismatches)
+
+        return self
+
+
+# Compiles the test and matches the output against <name>-checks.txt.
+class DumpTest(CompilerTest):
+    def __init__(self, test_path, flags, test_id):
+        CompilerTest.__init__(self, test_path, flags, test_id)
+
+    def run(self, runner):
+        test_abc = path.join(runner.tmp_dir, "%s.abc" % self.test_id)
+        os.makedirs(path.dirname(test_abc), exist_ok=True)
+
+        if not self.compile(runner, test_abc, self.path):
+            self.passed = False
+            return self
+
+        return self.check_output("%s-checks.txt" % (path.splitext(self.path)[0]))
+
+
+# A directory holding a project with the entry module main.js. The dumped
+# assembly of the project is matched against checks.txt.
+class ProjectTest(CompilerTest):
+    def __init__(self, test_path, flags, test_id):
+        CompilerTest.__init__(self, test_path, flags, test_id)
+
+    def run(self, runner):
+        # the modules are written next to their sources, so a copy is compiled
+        project_dir = path.join(runner.tmp_dir, self.test_id)
+        shutil.rmtree(project_dir, ignore_errors=True)
+        shutil.copytree(self.path, project_dir)
+
+        if not self.compile(runner, path.join(project_dir, "main.abc"),
+                            path.join(project_dir, "main.js")):
+            self.passed = False
+            return self
+
+        return self.check_output(path.join(self.path, "checks.txt"))
+
+
 class TSCTest(Test):
     def __init__(self, test_path, flags):
         Test.__init__(self, test_path, flags)
@@ -391,6 +569,26 @@ class Runner:
         if not path.isfile(self.es2panda):
             raise Exception("Cannot find es2panda binary: %s" % self.es2panda)
 
+    def setup_runtime(self):
+        self.cmd_env = os.environ.copy()
+        for san in ["ASAN_OPTIONS", "TSAN_OPTIONS", "MSAN_OPTIONS", "LSAN_OPTIONS"]:
+            # we don't want to interpret asan failures as SyntaxErrors
+            self.cmd_env[san] = ":exitcode=255"
+
+        self.runtime = path.join(self.args.build_dir, 'bin', 'ark')
+        if not path.isfile(self.runtime):
+            raise Exception("Cannot find runtime binary: %s" % self.runtime)
+
+        self.runtime_args = [
+            '--boot-panda-files=%s/pandastdlib/arkstdlib.abc'
+            % self.args.build_dir,
+            '--load-runtimes=ecmascript',
+            '--gc-type=%s' % self.args.gc_type,
+        ]
+
+        if not self.args.no_gip:
+            self.runtime_args += ['--run-gc-in-place']
+
     def add_directory(self, directory, extension, flags):
         pass
 
@@ -458,6 +656,21 @@ class RegressionRunner(Runner):
 
         self.tests += list(map(lambda f: Test(f, flags), files))
 
+    def add_snapshot_directory(self, directory, extension, flags):
+        glob_expression = path.join(
+            self.test_root, directory, "*.%s" % (extension))
+        files = glob(glob_expression)
+        files = fnmatch.filter(files, self.test_root + '**' + self.args.filter)
+
+        snapshot_dir = path.join(path.sep, 'tmp', 'panda', 'snapshot')
+        os.makedirs(snapshot_dir, exist_ok=True)
+
+        def get_snapshot_path(file):
+            test_id = path.relpath(path.splitext(file)[0], self.test_root)
+            return path.join(snapshot_dir, "%s.snap" % test_id.replace(path.sep, '_'))
+
+        self.tests += list(map(lambda f: SnapshotTest(f, flags, get_snapshot_path(f)), files))
+
     def test_path(self, src):
         return src
 
@@ -466,29 +679,13 @@ class Test262Runner(Runner):
     def __init__(self, args):
         Runner.__init__(self, args, "Test262 ark"),
 
-        self.cmd_env = os.environ.copy()
-        for san in ["ASAN_OPTIONS", "TSAN_OPTIONS", "MSAN_OPTIONS", "LSAN_OPTIONS"]:
-            # we don't want to interpret asan failures as SyntaxErrors
-            self.cmd_env[san] = ":exitcode=255"
+        self.setup_runtime()
 
         self.update = args.update
         self.enable_skiplists = False if self.update else args.skip
         self.normal_skiplist_file = "test262skiplist.txt"
         self.long_flaky_skiplist_files = ["test262skiplist-long.txt", "test262skiplist-flaky.txt"]
         self.normal_skiplist = set([])
-        self.runtime = path.join(args.build_dir, 'bin', 'ark')
-        if not path.isfile(self.runtime):
-            raise Exception("Cannot find runtime binary: %s" % self.runtime)
-
-        self.runtime_args = [
-            '--boot-panda-files=%s/pandastdlib/arkstdlib.abc'
-            % args.build_dir,
-            '--load-runtimes=ecmascript',
-            '--gc-type=%s' % args.gc_type,
-        ]
-
-        if not args.no_gip:
-            self.runtime_args += ['--run-gc-in-place']
 
         if args.aot:
             self.arkaot = path.join(args.build_dir, 'bin', 'ark_aot')
@@ -654,6 +851,61 @@ class Test262Runner(Runner):
         file.close()
 
 
+class CompilerRunner(Runner):
+    def __init__(self, args):
+        Runner.__init__(self, args, "Compiler")
+
+        self.setup_runtime()
+        self.tmp_dir = path.join(path.sep, 'tmp', 'panda', 'compiler')
+        os.makedirs(self.tmp_dir, exist_ok=True)
+
+    def add_directory(self, directory, extension, flags):
+        glob_expression = path.join(
+            self.test_root, directory, "*.%s" % (extension))
+        files = glob(glob_expression)
+        files = fnmatch.filter(files, self.test_root + '**' + self.args.filter)
+
+        def get_test_id(file):
+            return path.relpath(path.splitext(file)[0], self.test_root)
+
+        self.tests += list(map(lambda f: CompilerTest(f, flags, get_test_id(f)), files))
+
+    def add_cache_directory(self, directory, extension, flags):
+        glob_expression = path.join(
+            self.test_root, directory, "*.%s" % (extension))
+        files = glob(glob_expression)
+        files = fnmatch.filter(files, self.test_root + '**' + self.args.filter)
+
+        def get_test_id(file):
+            return path.relpath(path.splitext(file)[0], self.test_root)
+
+        self.tests += list(map(lambda f: CacheTest(f, flags, get_test_id(f)), files))
+
+    def add_dump_directory(self, directory, extension, flags):
+        glob_expression = path.join(
+            self.test_root, directory, "*.%s" % (extension))
+        files = glob(glob_expression)
+        files = fnmatch.filter(files, self.test_root + '**' + self.args.filter)
+
+        def get_test_id(file):
+            return path.relpath(path.splitext(file)[0], self.test_root)
+
+        self.tests += list(map(lambda f: DumpTest(f, flags, get_test_id(f)), files))
+
+    def add_project_directory(self, directory, flags):
+        glob_expression = path.join(self.test_root, directory, "*", "")
+        projects = [path.dirname(p) for p in glob(glob_expression)]
+        projects = fnmatch.filter(projects, self.test_root + '**' + self.args.filter)
+
+        def get_test_id(project):
+            return path.relpath(project, self.test_root)
+
+        self.tests += list(map(lambda p: ProjectTest(p, flags, get_test_id(p)), projects))
+
+    def test_path(self, src):
+        return src
+
+
 class TSCRunner(Runner):
     def __init__(self, args):
         Runner.__init__(self, args, "TSC")
@@ -720,6 +972,7 @@ def main():
     if args.regression:
         runner = RegressionRunner(args)
         runner.add_directory("parser/js", "js", ["--parse-only"])
+        runner.add_snapshot_directory("parser/js", "js", ["--parse-only"])
         # TODO(aszilagyi): reenable TS tests
         # runner.add_directory("parser/ts", "ts",
         #                      ["--parse-only", '--extension=ts'])
@@ -733,6 +986,19 @@ def main():
     if args.tsc:
         runners.append(TSCRunner(args))
 
+    if args.compiler:
+        runner = CompilerRunner(args)
+        runner.add_directory("compiler/ts/execute", "ts",
+                             ["--extension=ts", "--skip-type-check"])
+        runner.add_cache_directory("compiler/ts/execute", "ts",
+                                   ["--extension=ts", "--skip-type-check"])
+        runner.add_dump_directory("compiler/ts/dump", "ts",
+                                  ["--extension=ts", "--record-type", "--dump-assembly"])
+        runner.add_project_directory("compiler/js/project",
+                                     ["--project", "--dump-assembly"])
+
+        runners.append(runner)
+
     failed_tests = 0
 
     for runner in runners:
@@ -34,18 +34,58 @@ Checker::Checker(ArenaAllocator *allocator, binder::Binder *binder)
     : allocator_(allocator),
       binder_(binder),
       rootNode_(binder->TopScope()->Node()->AsBlockStatement()),
-      scope_(binder->TopScope())
+      scope_(binder->TopScope()),
+      numberLiteralMap_(allocator_->Adapter()),
+      stringLiteralMap_(allocator_->Adapter()),
+      bigintLiteralMap_(allocator_->Adapter()),
+      identicalResults_(allocator_),
+      assignableResults_(allocator_),
+      comparableResults_(allocator_),
+      typeStack_(allocator_->Adapter()),
+      nodeCache_(allocator_->Adapter()),
+      scopeStack_(allocator_->Adapter())
 {
     scopeStack_.push_back(scope_);
     globalTypes_ = allocator_->New<GlobalTypesHolder>(allocator_);
     relation_ = allocator_->New<TypeRelation>(this);
+
+    /* Keep literal types unique per value, so identical literals are always the same object */
+    numberLiteralMap_.insert({0, globalTypes_->GlobalZeroType()});
+    stringLiteralMap_.insert({"", globalTypes_->GlobalEmptyStringType()});
     status_ = CheckerStatus::NO_OPTS;
 }
 
-void Checker::StartChecker()
+void Checker::StartChecker(size_t maxErrors)
 {
     ASSERT(rootNode_->IsProgram());
-    rootNode_->Check(this);
+
+    for (const auto *it : rootNode_->Statements()) {
+        try {
+            it->Check(this);
+        } catch (const Error &e) {
+            RecordError(e);
+
+            if (errors_.size() >= maxErrors) {
+                return;
+            }
+        }
+    }
+}
+
+void Checker::RecordError(const Error &error)
+{
+    /* The failed statement left its bookkeeping behind, scopes are already restored by ScopeContext */
+    typeStack_.clear();
+    status_ = CheckerStatus::NO_OPTS;
+
+    /* Declarations are inferred lazily, so a broken one is reported again by each statement referencing it */
+    for (const auto &it : errors_) {
+        if (it.Line() == error.Line() && it.Col() == error.Col() && it.Message() == error.Message()) {
+            return;
+        }
+    }
+
+    errors_.push_back(error);
 }
 
 binder::Scope *Checker::Scope() const
@@ -227,12 +267,12 @@ RelationHolder &Checker::ComparableResults()
     return comparableResults_;
 }
 
-std::unordered_set<const ir::AstNode *> &Checker::TypeStack()
+ArenaUnorderedSet<const ir::AstNode *> &Checker::TypeStack()
 {
     return typeStack_;
 }
 
-std::unordered_map<const ir::AstNode *, Type *> &Checker::NodeCache()
+ArenaUnorderedMap<const ir::AstNode *, Type *> &Checker::NodeCache()
 {
     return nodeCache_;
 }
@@ -23,6 +23,7 @@
 #include <macros.h>
 #include <util/enumbitops.h>
 #include <util/ustring.h>
+#include <es2panda.h>
 
 #include <cstdint>
 #include <initializer_list>
@@ -104,13 +105,13 @@ enum class AstNodeType;
 
 namespace panda::es2panda::checker {
 
-using StringLiteralPool = std::unordered_map<util::StringView, Type *>;
-using NumberLiteralPool = std::unordered_map<double, Type *>;
+using StringLiteralPool = ArenaUnorderedMap<util::StringView, Type *>;
+using NumberLiteralPool = ArenaUnorderedMap<double, Type *>;
 using FunctionParamsResolveResult = std::variant<std::vector<binder::LocalVariable *> &, bool>;
-using InterfacePropertyMap = std::unordered_map<util::StringView, std::pair<binder::LocalVariable *, InterfaceType *>>;
+using InterfacePropertyMap = ArenaUnorderedMap<util::StringView, std::pair<binder::LocalVariable *, InterfaceType *>>;
 using TypeOrNode = std::variant<Type *, const ir::AstNode *>;
 using IndexInfoTypePair = std::pair<Type *, Type *>;
-using PropertyMap = std::unordered_map<util::StringView, binder::LocalVariable *>;
+using PropertyMap = ArenaUnorderedMap<util::StringView, binder::LocalVariable *>;
 
 enum class DestructuringType {
     NO_DESTRUCTURING,
@@ -182,7 +183,13 @@ public:
     NO_COPY_SEMANTIC(Checker);
     NO_MOVE_SEMANTIC(Checker);
 
-    void StartChecker();
+    // Checks the program statement by statement, stops after maxErrors type errors were collected
+    void StartChecker(size_t maxErrors);
+
+    const std::vector<Error> &Errors() const
+    {
+        return errors_;
+    }
 
     ArenaAllocator *Allocator() const
     {
@@ -232,8 +239,8 @@ public:
     RelationHolder &AssignableResults();
     RelationHolder &ComparableResults();
 
-    std::unordered_set<const ir::AstNode *> &TypeStack();
-    std::unordered_map<const ir::AstNode *, Type *> &NodeCache();
+    ArenaUnorderedSet<const ir::AstNode *> &TypeStack();
+    ArenaUnorderedMap<const ir::AstNode *, Type *> &NodeCache();
     Type *CheckTypeCached(const ir::Expression *expr);
 
     CheckerStatus Status();
@@ -471,6 +478,8 @@ public:
     friend class ScopeContext;
 
 private:
+    void RecordError(const Error &error);
+
     ArenaAllocator *allocator_;
     binder::Binder *binder_;
     const ir::BlockStatement *rootNode_;
@@ -487,11 +496,12 @@ private:
     RelationHolder assignableResults_;
     RelationHolder comparableResults_;
 
-    std::unordered_set<const ir::AstNode *> typeStack_;
-    std::unordered_map<const ir::AstNode *, Type *> nodeCache_;
-    std::vector<binder::Scope *> scopeStack_;
+    ArenaUnorderedSet<const ir::AstNode *> typeStack_;
+    ArenaUnorderedMap<const ir::AstNode *, Type *> nodeCache_;
+    ArenaVector<binder::Scope *> scopeStack_;
 
     CheckerStatus status_;
+    std::vector<Error> errors_;
 };
 
 class ScopeContext {
@@ -514,6 +524,30 @@ private:
     binder::Scope *prevScope_;
 };
 
+// Restores the type parameter defaults overwritten for an instantiation, also when checking an argument throws
+class DefaultTypeOverrides {
+public:
+    DefaultTypeOverrides() = default;
+    NO_COPY_SEMANTIC(DefaultTypeOverrides);
+    NO_MOVE_SEMANTIC(DefaultTypeOverrides);
+
+    ~DefaultTypeOverrides()
+    {
+        for (auto it = saved_.rbegin(); it != saved_.rend(); it++) {
+            (*it).first->SetDefaultType((*it).second);
+        }
+    }
+
+    void Override(TypeParameter *param, Type *defaultType)
+    {
+        saved_.emplace_back(param, param->DefaultType());
+        param->SetDefaultType(defaultType);
+    }
+
+private:
+    std::vector<std::pair<TypeParameter *, Type *>> saved_;
+};
+
 }  // namespace panda::es2panda::checker
 
 #endif /* CHECKER_H */
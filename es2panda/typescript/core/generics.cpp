@@ -52,7 +52,7 @@ Type *Checker::InstantiateGenericTypeAlias(binder::Variable *bindingVar, const i
     ValidateTypeParameterInstantiation(decl->Params().size(), decl->RequiredParams(),
                                        typeParams ? typeParams->Params().size() : 0, bindingVar->Name(), locInfo);
 
-    std::vector<std::pair<TypeParameter *, Type *>> savedDefaultTypes;
+    DefaultTypeOverrides overrides;
 
     if (typeParams) {
         ScopeContext scopeCtx(this, decl->Scope());
@@ -64,19 +64,11 @@ Type *Checker::InstantiateGenericTypeAlias(binder::Variable *bindingVar, const i
 
             TypeParameter *currentTypeParameterType = res.variable->TsType()->AsTypeParameter();
 
-            savedDefaultTypes.emplace_back(currentTypeParameterType, currentTypeParameterType->DefaultType());
-
-            currentTypeParameterType->SetDefaultType(typeParams->Params()[it]->Check(this));
+            overrides.Override(currentTypeParameterType, typeParams->Params()[it]->Check(this));
         }
     }
 
-    Type *newGenericType = bindingVar->TsType()->Instantiate(allocator_, relation_, globalTypes_);
-
-    for (auto it : savedDefaultTypes) {
-        it.first->SetDefaultType(it.second);
-    }
-
-    return newGenericType;
+    return bindingVar->TsType()->Instantiate(allocator_, relation_, globalTypes_);
 }
 
 Type *Checker::InstantiateGenericInterface(binder::Variable *bindingVar, const binder::Decl *decl,
@@ -97,14 +89,10 @@ Type *Checker::InstantiateGenericInterface(binder::Variable *bindingVar, const b
         }
     }
 
-    std::vector<std::pair<TypeParameter *, Type *>> savedDefaultTypes;
+    DefaultTypeOverrides overrides;
 
     for (size_t i = 0; i < typeParamInstantiationTypes.size(); i++) {
-        TypeParameter *mergedTypeParam = mergedTypeParams.first[i]->TsType()->AsTypeParameter();
-
-        savedDefaultTypes.emplace_back(mergedTypeParam, mergedTypeParam->DefaultType());
-
-        mergedTypeParam->SetDefaultType(typeParamInstantiationTypes[i]);
+        overrides.Override(mergedTypeParams.first[i]->TsType()->AsTypeParameter(), typeParamInstantiationTypes[i]);
     }
 
     const auto &declarations = decl->AsInterfaceDecl()->Decls();
@@ -127,10 +115,8 @@ Type *Checker::InstantiateGenericInterface(binder::Variable *bindingVar, const b
 
             TypeParameter *currentTypeParameterType = res.variable->TsType()->AsTypeParameter();
 
-            savedDefaultTypes.emplace_back(currentTypeParameterType, currentTypeParameterType->DefaultType());
-
-            currentTypeParameterType->SetDefaultType(
-                mergedTypeParams.first[i]->TsType()->AsTypeParameter()->DefaultType());
+            overrides.Override(currentTypeParameterType,
+                               mergedTypeParams.first[i]->TsType()->AsTypeParameter()->DefaultType());
         }
     }
 
@@ -138,10 +124,6 @@ Type *Checker::InstantiateGenericInterface(binder::Variable *bindingVar, const b
 
     newGenericType->AsObjectType()->AsInterfaceType()->SetTypeParamTypes(std::move(typeParamInstantiationTypes));
 
-    for (auto it = savedDefaultTypes.rbegin(); it != savedDefaultTypes.rend(); it++) {
-        (*it).first->SetDefaultType((*it).second);
-    }
-
     return newGenericType;
 }
 
@@ -21,7 +21,6 @@
 #include <macros.h>
 #include <util/ustring.h>
 
-#include <unordered_map>
 #include <variant>
 
 namespace panda::es2panda::checker {
@@ -45,7 +44,16 @@ class RelationKeyHasher {
 public:
     size_t operator()(const RelationKey &key) const noexcept
     {
-        return static_cast<size_t>(key.sourceId ^ key.targetId);
+        // Type ids are small and sequential, so mix both of them to keep swapped and neighbouring pairs apart
+        constexpr uint64_t GOLDEN_RATIO = 0x9E3779B97F4A7C15ULL;
+        constexpr uint64_t MIX_MULTIPLIER = 0xFF51AFD7ED558CCDULL;
+        constexpr uint32_t MIX_SHIFT = 33;
+
+        uint64_t hash = key.sourceId * GOLDEN_RATIO + key.targetId;
+        hash ^= hash >> MIX_SHIFT;
+        hash *= MIX_MULTIPLIER;
+        hash ^= hash >> MIX_SHIFT;
+        return static_cast<size_t>(hash);
     }
 };
 
@@ -63,10 +71,12 @@ public:
     RelationType type;
 };
 
-using RelationMap = std::unordered_map<RelationKey, RealtionEntry, RelationKeyHasher, RelationKeyComparator>;
+using RelationMap = ArenaUnorderedMap<RelationKey, RealtionEntry, RelationKeyHasher, RelationKeyComparator>;
 
 class RelationHolder {
 public:
+    explicit RelationHolder(ArenaAllocator *allocator) : cached(allocator->Adapter()) {}
+
     RelationMap cached;
     RelationType type {};
 };
@@ -16,6 +16,7 @@
 #include "unionType.h"
 #include <algorithm>
 
+#include <typescript/checker.h>
 #include <typescript/types/globalTypesHolder.h>
 
 namespace panda::es2panda::checker {
@@ -147,27 +148,46 @@ TypeFacts UnionType::GetTypeFacts() const
     return facts;
 }
 
+static bool IsUniqueType(const Type *type)
+{
+    /* Primitive types are singletons and number, string and boolean literal types are pooled by value, so two of
+     * them are identical only if they are the same object. Bigint literals are not included, as their pool ignores
+     * the sign. */
+    const TypeFlag UNIQUE_TYPES = TypeFlag::NUMBER | TypeFlag::STRING | TypeFlag::BOOLEAN | TypeFlag::BIGINT |
+                                  TypeFlag::VOID | TypeFlag::NULL_TYPE | TypeFlag::UNDEFINED | TypeFlag::UNKNOWN |
+                                  TypeFlag::NEVER | TypeFlag::ANY | TypeFlag::NON_PRIMITIVE |
+                                  TypeFlag::NUMBER_LITERAL | TypeFlag::STRING_LITERAL | TypeFlag::BOOLEAN_LITERAL;
+    return type->HasTypeFlag(UNIQUE_TYPES);
+}
+
 void UnionType::RemoveDuplicatedTypes(TypeRelation *relation, std::vector<Type *> &constituentTypes)
 {
-    auto compare = constituentTypes.begin();
+    ArenaUnorderedSet<const Type *> seen(relation->GetChecker()->Allocator()->Adapter());
+    std::vector<const Type *> structuralTypes;
 
-    while (compare != constituentTypes.end()) {
-        auto it = compare + 1;
+    auto last = std::remove_if(constituentTypes.begin(), constituentTypes.end(), [&](const Type *type) {
+        if (!seen.insert(type).second) {
+            return true;
+        }
 
-        while (it != constituentTypes.end()) {
-            relation->Result(false);
+        if (IsUniqueType(type)) {
+            return false;
+        }
 
-            (*compare)->Identical(relation, *it);
+        for (const auto *it : structuralTypes) {
+            relation->Result(false);
+            it->Identical(relation, type);
 
             if (relation->IsTrue()) {
-                it = constituentTypes.erase(it);
-            } else {
-                it++;
+                return true;
             }
         }
 
-        compare = it;
-    }
+        structuralTypes.push_back(type);
+        return false;
+    });
+
+    constituentTypes.erase(last, constituentTypes.end());
 }
 
 Type *UnionType::HandleUnionType(UnionType *unionType, GlobalTypesHolder *globalTypesHolder)
@@ -231,7 +251,8 @@ void UnionType::RemoveRedundantLiteralTypesFromUnion(UnionType *type)
 
 Type *UnionType::Instantiate(ArenaAllocator *allocator, TypeRelation *relation, GlobalTypesHolder *globalTypes)
 {
-    std::vector<Type *> copiedConstituents(constituentTypes_.size());
+    std::vector<Type *> copiedConstituents;
+    copiedConstituents.reserve(constituentTypes_.size());
 
     for (auto *it : constituentTypes_) {
         copiedConstituents.push_back(it->Instantiate(allocator, relation, globalTypes));
@@ -30,6 +30,7 @@
 #include <ir/expressions/objectExpression.h>
 #include <ir/statements/variableDeclaration.h>
 #include <ir/statements/variableDeclarator.h>
+#include <ir/ts/tsParameterProperty.h>
 
 namespace panda::es2panda::util {
 
@@ -281,6 +282,10 @@ static void CollectBindingName(const ir::AstNode *node, std::vector<const ir::Id
             CollectBindingName(node->AsRestElement()->Argument(), bindings);
             break;
         }
+        case ir::AstNodeType::TS_PARAMETER_PROPERTY: {
+            CollectBindingName(node->AsTSParameterProperty()->Parameter(), bindings);
+            break;
+        }
         default:
             break;
     }
@@ -388,6 +393,9 @@ std::tuple<util::StringView, bool> Helpers::ParamName(ArenaAllocator *allocator,
             }
             break;
         }
+        case ir::AstNodeType::TS_PARAMETER_PROPERTY: {
+            return ParamName(allocator, param->AsTSParameterProperty()->Parameter(), index);
+        }
         default:
             break;
     }
@@ -48,4 +48,28 @@ namespace ARK::Ts2Abc::Ts2Abc {
         std::string output = ParseString(input);
         EXPECT_EQ(output, expected);
     }
+
+    HWTEST_F(StringArrTest, StringArrTest_UnicodeEscape, TestSize.Level0)
+    {
+        std::string input = "Hello\\u0041World";
+        std::string expected = "HelloAWorld";
+        std::string output = ParseString(input);
+        EXPECT_EQ(output, expected);
+    }
+
+    HWTEST_F(StringArrTest, StringArrTest_EscapedUnicodeEscape, TestSize.Level0)
+    {
+        std::string input = "Hello\\\\u0041World";
+        std::string expected = "Hello\\u0041World";
+        std::string output = ParseString(input);
+        EXPECT_EQ(output, expected);
+    }
+
+    HWTEST_F(StringArrTest, StringArrTest_NonAsciiChar, TestSize.Level0)
+    {
+        std::string input = "Hello \u4e16\u754c World";
+        std::string expected = "Hello \u4e16\u754c World";
+        std::string output = ParseString(input);
+        EXPECT_EQ(output, expected);
+    }
 } // namespace ARK::Ts2Abc::Ts2Abc
\ No newline at end of file
@@ -17,6 +17,8 @@
 #include "assembler/meta.h"
 #include "assembler/assembly-parser.h"
 
+#include <array>
+
 namespace ts2abc_type_adapter::type_adapter_test {
 using ArrayValue = panda::pandasm::ArrayValue;
 using ScalarValue = panda::pandasm::ScalarValue;
@@ -47,6 +49,7 @@ public:
 class TypeAdapterTest : TestBase {
 public:
     void TestVariablesArgsType() const;
+    void TestMultipleFunctionsType() const;
     void TestBuiltinsType() const;
 
     std::unordered_map<int32_t, int32_t> ExtractTypeinfo(const panda::pandasm::Function &fun) const
@@ -76,6 +79,17 @@ public:
         ScalarValue insn_type(ScalarValue::Create<panda::pandasm::Value::Type::I32>(type));
         elements->emplace_back(std::move(insn_type));
     }
+
+    void SetTypeinfo(panda::pandasm::Function *fun, const std::vector<ScalarValue> &elements) const
+    {
+        ArrayValue arr(panda::pandasm::Value::Type::I32, elements);
+        AnnotationElement anno_ele(TypeAdapter::TSTYPE_ANNO_ELEMENT_NAME, std::make_unique<ArrayValue>(arr));
+        AnnotationData anno_data(TypeAdapter::TSTYPE_ANNO_RECORD_NAME);
+        anno_data.AddElement(std::move(anno_ele));
+        std::vector<panda::pandasm::AnnotationData> annos;
+        annos.emplace_back(std::move(anno_data));
+        fun->metadata->SetAnnotations(std::move(annos));
+    }
 };
 
 void TypeAdapterTest::TestVariablesArgsType() const
@@ -133,6 +147,73 @@ void TypeAdapterTest::TestVariablesArgsType() const
     const int32_t instruction_location = 8;
     CheckTypeExist(typeinfo, instruction_location, 1);
 }
+
+void TypeAdapterTest::TestMultipleFunctionsType() const
+{
+    std::string source = R"(
+        .function any foo() {
+            ecma.ldlexenvdyn
+            sta.dyn v0
+            lda.dyn v0
+            sta.dyn v1
+            lda.dyn v1
+            return.dyn
+        }
+        .function any bar() {
+            ecma.ldlexenvdyn
+            sta.dyn v1
+            lda.dyn v1
+            sta.dyn v0
+            lda.dyn v0
+            sta.dyn v1
+            return.dyn
+        }
+        .function any baz() {
+            ecma.ldlexenvdyn
+            sta.dyn v2
+            lda.dyn v2
+            return.dyn
+        }
+    )";
+    panda::pandasm::Parser p;
+    auto res = p.Parse(source);
+    auto &program = res.Value();
+    const std::array<std::string, 3> names = {"foo", "bar", "baz"};
+    for (size_t i = 0; i < names.size(); i++) {
+        auto it = program.function_table.find(names[i]);
+        TestAssertNotEqual(it, program.function_table.end());
+        std::vector<ScalarValue> elements;
+        // vreg 1 is typed in every function, vreg 0 and vreg 2 only in some of them
+        AddTypeinfo(&elements, 1, static_cast<int32_t>(i + 1));
+        AddTypeinfo(&elements, 0, static_cast<int32_t>(i + 1));
+        SetTypeinfo(&it->second, elements);
+    }
+
+    // functions are adapted concurrently
+    const size_t thread_count = 3;
+    TypeAdapter ta(false, thread_count);
+    ta.AdaptTypeForProgram(&program);
+
+    // only the first sta.dyn to each vreg carries its type
+    const auto foo = ExtractTypeinfo(program.function_table.at("foo"));
+    const size_t foo_types = 2;
+    TestAssertEqual(foo.size(), foo_types);
+    CheckTypeExist(foo, 1, 1);
+    const int32_t foo_second_store = 3;
+    CheckTypeExist(foo, foo_second_store, 1);
+
+    const auto bar = ExtractTypeinfo(program.function_table.at("bar"));
+    const size_t bar_types = 2;
+    const int32_t bar_type = 2;
+    TestAssertEqual(bar.size(), bar_types);
+    CheckTypeExist(bar, 1, bar_type);
+    const int32_t bar_second_store = 3;
+    CheckTypeExist(bar, bar_second_store, bar_type);
+
+    // vreg 2 has no type, so nothing is recorded
+    const auto baz = ExtractTypeinfo(program.function_table.at("baz"));
+    TestAssertEqual(baz.size(), 0);
+}
 }  // namespace ts2abc_type_adapter::type_adapter_test
 
 int main()
@@ -141,6 +222,9 @@ int main()
     std::cout << "TypeAdapterTest TestVariablesArgsType: " << std::endl;
     test.TestVariablesArgsType();
     std::cout << "PASS!" << std::endl;
+    std::cout << "TypeAdapterTest TestMultipleFunctionsType: " << std::endl;
+    test.TestMultipleFunctionsType();
+    std::cout << "PASS!" << std::endl;
     return 0;
     // should enable TestBuiltinsType when builtins adaption is ready
 }
@@ -13,11 +13,13 @@
  * limitations under the License.
  */
 
-#include <codecvt>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <cstdarg>
 #include <iostream>
-#include <locale>
 #include <string>
+#include <string_view>
 #include <unistd.h>
 
 #include "assembly-type.h"
@@ -147,74 +149,194 @@ static void Logd(const char *format, ...)
     }
 }
 
-static std::u16string ConvertUtf8ToUtf16(const std::string &data)
+static void AppendUtf16AsMUtf8(const uint16_t *u16Data, size_t u16DataSize, std::string *out)
 {
-    std::u16string u16Data = std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> {}.from_bytes(data);
-    return u16Data;
-}
+    if (u16DataSize == 0) {
+        return;
+    }
 
-static std::string ConvertUtf16ToMUtf8(const uint16_t *u16Data, size_t u16DataSize)
-{
+    // the size includes the terminating zero, which is dropped again after the conversion
     size_t mutf8DataLen = panda::utf::Utf16ToMUtf8Size(u16Data, u16DataSize);
-    std::vector<uint8_t> mutf8Data(mutf8DataLen);
+    size_t offset = out->size();
+    out->resize(offset + mutf8DataLen);
 
-    panda::utf::ConvertRegionUtf16ToMUtf8(u16Data, mutf8Data.data(), u16DataSize, mutf8DataLen - 1, 0);
+    panda::utf::ConvertRegionUtf16ToMUtf8(u16Data, reinterpret_cast<uint8_t *>(out->data() + offset), u16DataSize,
+                                          mutf8DataLen - 1, 0);
 
-    std::string ret = std::string(reinterpret_cast<char *>(mutf8Data.data()));
-    return ret;
+    size_t end = out->find('\0', offset);
+    if (end != std::string::npos) {
+        out->resize(end);
+    }
 }
 
-static std::string ConvertUtf8ToMUtf8(const std::string &data)
+static bool IsPlainAscii(char c)
 {
-    // WARN: std::u16string is set of uint_least16_t characters.
-    std::u16string u16String = ConvertUtf8ToUtf16(data);
-    uint16_t *u16Data = reinterpret_cast<uint16_t *>(u16String.data());
-    size_t u16DataSize = u16String.size();
-    return ConvertUtf16ToMUtf8(u16Data, u16DataSize);
+    auto byte = static_cast<unsigned char>(c);
+    return byte != 0 && byte < 0x80 && c != '\\';
 }
 
-static std::string ParseUnicodeEscapeString(const std::string &data)
+// Length of the prefix which is the same in UTF-8 and MUTF-8 and contains no escape, checked a word at a time
+static size_t PlainAsciiPrefixLength(const char *data, size_t size)
 {
-    const int unicodeEscapeSymbolLen = 2;
-    const int unicodeCharacterLen = 4;
-    const int base = 16;
-    std::string::size_type startIdx = 0;
-    std::string newData = "";
-    std::string::size_type len = data.length();
-    while (true) {
-        std::string unicodeStr = "\\u";
-        std::string::size_type index = data.find(unicodeStr, startIdx);
-        if (index == std::string::npos) {
+    constexpr uint64_t ONES = 0x0101010101010101ULL;
+    constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+    constexpr uint64_t BACKSLASHES = ONES * static_cast<uint8_t>('\\');
+
+    size_t len = 0;
+
+    for (; len + sizeof(uint64_t) <= size; len += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        if (memcpy_s(&word, sizeof(word), data + len, sizeof(word)) != EOK) {
             break;
         }
-        if (index != 0 && data[index - 1] == '\\') {
-            std::string tmpStr = data.substr(startIdx, index - 1 - startIdx) +
-                                data.substr(index, unicodeEscapeSymbolLen); // delete a '\\'
-            newData += ConvertUtf8ToMUtf8(tmpStr);
-            startIdx = index + unicodeEscapeSymbolLen;
-        } else {
-            std::string tmpStr = data.substr(startIdx, index - startIdx);
-            newData += ConvertUtf8ToMUtf8(tmpStr);
-            std::string uStr = data.substr(index + unicodeEscapeSymbolLen, unicodeCharacterLen);
-            uint16_t u16Data = static_cast<uint16_t>(std::stoi(uStr.c_str(), NULL, base));
-            newData += ConvertUtf16ToMUtf8(&u16Data, 1);
-            startIdx = index + unicodeEscapeSymbolLen + unicodeCharacterLen;
+
+        uint64_t escapes = word ^ BACKSLASHES;
+        uint64_t zeroBytes = (word - ONES) & ~word;
+        uint64_t escapeBytes = (escapes - ONES) & ~escapes;
+
+        if (((word | zeroBytes | escapeBytes) & HIGH_BITS) != 0) {
+            break;
         }
     }
-    if (startIdx != len) {
-        std::string tmpStr = data.substr(startIdx);
-        newData += ConvertUtf8ToMUtf8(tmpStr);
+
+    while (len < size && IsPlainAscii(data[len])) {
+        len++;
+    }
+
+    return len;
+}
+
+// Decodes one UTF-8 sequence into UTF-16 code units, malformed input is replaced by U+FFFD
+static size_t DecodeUtf8(const char *data, size_t size, std::vector<uint16_t> *u16Data)
+{
+    constexpr uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+    constexpr uint32_t MAX_BMP_CODE_POINT = 0xFFFF;
+    constexpr uint32_t MAX_CODE_POINT = 0x10FFFF;
+    constexpr uint32_t SURROGATE_OFFSET = 0x10000;
+    constexpr uint32_t HIGH_SURROGATE_BASE = 0xD800;
+    constexpr uint32_t LOW_SURROGATE_BASE = 0xDC00;
+    constexpr uint32_t SURROGATE_BITS = 10;
+    constexpr uint32_t SURROGATE_MASK = 0x3FF;
+    constexpr uint32_t CONTINUATION_BITS = 6;
+    constexpr uint8_t CONTINUATION_MASK = 0xC0;
+    constexpr uint8_t CONTINUATION_TAG = 0x80;
+    constexpr uint8_t TWO_BYTES_TAG = 0xC0;
+    constexpr uint8_t THREE_BYTES_TAG = 0xE0;
+    constexpr uint8_t FOUR_BYTES_TAG = 0xF0;
+    constexpr uint8_t FIVE_BYTES_TAG = 0xF8;
+    constexpr std::array<uint32_t, 5> MIN_CODE_POINTS = {0, 0, 0x80, 0x800, 0x10000};
+
+    auto lead = static_cast<uint8_t>(data[0]);
+    size_t len = 1;
+    uint32_t codePoint = lead;
+
+    if (lead >= FOUR_BYTES_TAG && lead < FIVE_BYTES_TAG) {
+        len = 4;  // 4: length of a four bytes sequence
+        codePoint = lead & ~FOUR_BYTES_TAG;
+    } else if (lead >= THREE_BYTES_TAG && lead < FOUR_BYTES_TAG) {
+        len = 3;  // 3: length of a three bytes sequence
+        codePoint = lead & ~THREE_BYTES_TAG;
+    } else if (lead >= TWO_BYTES_TAG && lead < THREE_BYTES_TAG) {
+        len = 2;  // 2: length of a two bytes sequence
+        codePoint = lead & ~TWO_BYTES_TAG;
+    } else if (lead >= CONTINUATION_TAG) {
+        u16Data->push_back(REPLACEMENT_CHARACTER);
+        return 1;
+    }
+
+    for (size_t i = 1; i < len; i++) {
+        if (i >= size || (static_cast<uint8_t>(data[i]) & CONTINUATION_MASK) != CONTINUATION_TAG) {
+            u16Data->push_back(REPLACEMENT_CHARACTER);
+            return i;
+        }
+
+        codePoint = (codePoint << CONTINUATION_BITS) | (static_cast<uint8_t>(data[i]) & ~CONTINUATION_MASK);
     }
-    return newData;
+
+    if (codePoint < MIN_CODE_POINTS[len] || codePoint > MAX_CODE_POINT) {
+        codePoint = REPLACEMENT_CHARACTER;
+    }
+
+    if (codePoint <= MAX_BMP_CODE_POINT) {
+        u16Data->push_back(static_cast<uint16_t>(codePoint));
+    } else {
+        codePoint -= SURROGATE_OFFSET;
+        u16Data->push_back(static_cast<uint16_t>(HIGH_SURROGATE_BASE + (codePoint >> SURROGATE_BITS)));
+        u16Data->push_back(static_cast<uint16_t>(LOW_SURROGATE_BASE + (codePoint & SURROGATE_MASK)));
+    }
+
+    return len;
 }
 
 std::string ParseString(const std::string &data)
 {
-    if (data.find("\\u") != std::string::npos) {
-        return ParseUnicodeEscapeString(data);
+    const size_t unicodeEscapeSymbolLen = 2;
+    const size_t unicodeCharacterLen = 4;
+    const int base = 16;
+
+    std::string newData;
+    newData.reserve(data.size());
+
+    // non ASCII text is converted in segments, so surrogate pairs are kept together
+    std::vector<uint16_t> u16Segment;
+    const char *chars = data.data();
+    size_t size = data.size();
+    size_t pos = 0;
+    size_t literalBackslash = std::string::npos;
+
+    auto flushSegment = [&newData, &u16Segment]() {
+        AppendUtf16AsMUtf8(u16Segment.data(), u16Segment.size(), &newData);
+        u16Segment.clear();
+    };
+
+    while (pos < size) {
+        size_t plainLen = PlainAsciiPrefixLength(chars + pos, size - pos);
+
+        if (plainLen != 0) {
+            flushSegment();
+            newData.append(chars + pos, plainLen);
+            pos += plainLen;
+            continue;
+        }
+
+        if (chars[pos] == '\\') {
+            flushSegment();
+
+            if (pos + 1 == size || chars[pos + 1] != 'u') {
+                literalBackslash = pos;
+                newData.push_back(chars[pos++]);
+                continue;
+            }
+
+            if (pos != 0 && literalBackslash == pos - 1) {
+                newData.pop_back();  // delete a '\\'
+                newData.append(chars + pos, unicodeEscapeSymbolLen);
+                pos += unicodeEscapeSymbolLen;
+                continue;
+            }
+
+            pos += unicodeEscapeSymbolLen;
+
+            // the code unit is parsed like std::stoi would, the copy fits into the small string buffer
+            std::string uStr(chars + pos, std::min(unicodeCharacterLen, size - pos));
+            char *uStrEnd = nullptr;
+            auto u16Data = static_cast<uint16_t>(std::strtol(uStr.c_str(), &uStrEnd, base));
+
+            if (uStrEnd == uStr.c_str()) {
+                newData.append(chars + pos - unicodeEscapeSymbolLen, unicodeEscapeSymbolLen);
+                continue;
+            }
+
+            AppendUtf16AsMUtf8(&u16Data, 1, &newData);
+            pos += uStr.size();
+            continue;
+        }
+
+        pos += DecodeUtf8(chars + pos, size - pos, &u16Segment);
     }
 
-    return ConvertUtf8ToMUtf8(data);
+    flushSegment();
+    return newData;
 }
 
 static void ParseLiteral(const Json::Value &literal, std::vector<panda::pandasm::LiteralArray::Literal> &literalArray)
@@ -324,33 +446,42 @@ static panda::pandasm::Record ParseRecord(const Json::Value &record)
     return pandaRecord;
 }
 
+// Looks the member up once, instead of isMember followed by operator[]
+static const Json::Value *FindMember(const Json::Value &object, std::string_view key)
+{
+    return object.find(key.data(), key.data() + key.size());
+}
+
 static void ParseInstructionOpCode(const Json::Value &ins, panda::pandasm::Ins &pandaIns)
 {
-    if (ins.isMember("o") && ins["o"].isInt()) {
-        auto opcode = ins["o"].asInt();
-        if (g_opcodeMap.find(opcode) != g_opcodeMap.end()) {
-            pandaIns.opcode = g_opcodeMap[opcode];
+    const Json::Value *opcodeValue = FindMember(ins, "o");
+    if (opcodeValue != nullptr && opcodeValue->isInt()) {
+        auto opcode = g_opcodeMap.find(opcodeValue->asInt());
+        if (opcode != g_opcodeMap.end()) {
+            pandaIns.opcode = opcode->second;
         }
     }
 }
 
 static void ParseInstructionRegs(const Json::Value &ins, panda::pandasm::Ins &pandaIns)
 {
-    if (ins.isMember("r") && ins["r"].isArray()) {
-        auto regs = ins["r"];
-        for (Json::ArrayIndex i = 0; i < regs.size(); ++i) {
-            pandaIns.regs.emplace_back(regs[i].asUInt());
+    const Json::Value *regs = FindMember(ins, "r");
+    if (regs != nullptr && regs->isArray()) {
+        pandaIns.regs.reserve(regs->size());
+        for (const auto &reg : *regs) {
+            pandaIns.regs.emplace_back(reg.asUInt());
         }
     }
 }
 
 static void ParseInstructionIds(const Json::Value &ins, panda::pandasm::Ins &pandaIns)
 {
-    if (ins.isMember("id") && ins["id"].isArray()) {
-        auto ids = ins["id"];
-        for (Json::ArrayIndex i = 0; i < ids.size(); ++i) {
-            if (ids[i].isString()) {
-                pandaIns.ids.emplace_back(ParseString(ids[i].asString()));
+    const Json::Value *ids = FindMember(ins, "id");
+    if (ids != nullptr && ids->isArray()) {
+        pandaIns.ids.reserve(ids->size());
+        for (const auto &id : *ids) {
+            if (id.isString()) {
+                pandaIns.ids.emplace_back(ParseString(id.asString()));
             }
         }
     }
@@ -358,11 +489,11 @@ static void ParseInstructionIds(const Json::Value &ins, panda::pandasm::Ins &pan
 
 static void ParseInstructionImms(const Json::Value &ins, panda::pandasm::Ins &pandaIns)
 {
-    if (ins.isMember("im") && ins["im"].isArray()) {
-        auto imms = ins["im"];
-        for (Json::ArrayIndex i = 0; i < imms.size(); ++i) {
-            double imsValue = imms[i].asDouble();
-            Logd("imm: %lf ", imsValue);
+    const Json::Value *imms = FindMember(ins, "im");
+    if (imms != nullptr && imms->isArray()) {
+        pandaIns.imms.reserve(imms->size());
+        for (const auto &imm : *imms) {
+            double imsValue = imm.asDouble();
             double intpart;
             if (std::modf(imsValue, &intpart) == 0.0 && IsValidInt32(imsValue)) {
                 pandaIns.imms.emplace_back(static_cast<int64_t>(imsValue));
@@ -375,61 +506,62 @@ static void ParseInstructionImms(const Json::Value &ins, panda::pandasm::Ins &pa
 
 static void ParseInstructionLabel(const Json::Value &ins, panda::pandasm::Ins &pandaIns)
 {
-    if (ins.isMember("l") && ins["l"].isString()) {
-        std::string label = ins["l"].asString();
-        if (label.length() != 0) {
-            Logd("label:\t%s", label.c_str());
+    const Json::Value *label = FindMember(ins, "l");
+    if (label != nullptr && label->isString()) {
+        pandaIns.label = label->asString();
+        if (pandaIns.label.length() != 0) {
             pandaIns.set_label = true;
-            pandaIns.label = label;
-            Logd("pandaIns.label:\t%s", pandaIns.label.c_str());
         }
     }
 }
 
 static void ParseInstructionDebugInfo(const Json::Value &ins, panda::pandasm::Ins &pandaIns)
 {
-    panda::pandasm::debuginfo::Ins insDebug;
-    if (ins.isMember("d") && ins["d"].isObject()) {
-        auto debugPosInfo = ins["d"];
-        if (GetDebugModeEnabled()) {
-            if (debugPosInfo.isMember("bl") && debugPosInfo["bl"].isInt()) {
-                insDebug.bound_left = debugPosInfo["bl"].asUInt();
-            }
+    auto &insDebug = pandaIns.ins_debug;
+    const Json::Value *debugPosInfo = FindMember(ins, "d");
+    if (debugPosInfo == nullptr || !debugPosInfo->isObject()) {
+        return;
+    }
 
-            if (debugPosInfo.isMember("br") && debugPosInfo["br"].isInt()) {
-                insDebug.bound_right = debugPosInfo["br"].asUInt();
-            }
+    if (GetDebugModeEnabled()) {
+        const Json::Value *boundLeft = FindMember(*debugPosInfo, "bl");
+        if (boundLeft != nullptr && boundLeft->isInt()) {
+            insDebug.bound_left = boundLeft->asUInt();
+        }
 
-            // whole line
-            if (debugPosInfo.isMember("w") && debugPosInfo["w"].isString()) {
-                insDebug.whole_line = debugPosInfo["w"].asString();
-            }
+        const Json::Value *boundRight = FindMember(*debugPosInfo, "br");
+        if (boundRight != nullptr && boundRight->isInt()) {
+            insDebug.bound_right = boundRight->asUInt();
+        }
 
-            // column number
-            if (debugPosInfo.isMember("c") && debugPosInfo["c"].isInt()) {
-                insDebug.column_number = debugPosInfo["c"].asInt();
-            }
+        // whole line
+        const Json::Value *wholeLine = FindMember(*debugPosInfo, "w");
+        if (wholeLine != nullptr && wholeLine->isString()) {
+            insDebug.whole_line = wholeLine->asString();
         }
 
-        // line number
-        if (debugPosInfo.isMember("l") && debugPosInfo["l"].isInt()) {
-            insDebug.line_number = debugPosInfo["l"].asInt();
+        // column number
+        const Json::Value *column = FindMember(*debugPosInfo, "c");
+        if (column != nullptr && column->isInt()) {
+            insDebug.column_number = column->asInt();
         }
     }
 
-    pandaIns.ins_debug = insDebug;
+    // line number
+    const Json::Value *line = FindMember(*debugPosInfo, "l");
+    if (line != nullptr && line->isInt()) {
+        insDebug.line_number = line->asInt();
+    }
 }
 
-static panda::pandasm::Ins ParseInstruction(const Json::Value &ins)
+static void ParseInstruction(const Json::Value &ins, panda::pandasm::Ins &pandaIns)
 {
-    panda::pandasm::Ins pandaIns;
     ParseInstructionOpCode(ins, pandaIns);
     ParseInstructionRegs(ins, pandaIns);
     ParseInstructionIds(ins, pandaIns);
     ParseInstructionImms(ins, pandaIns);
     ParseInstructionLabel(ins, pandaIns);
     ParseInstructionDebugInfo(ins, pandaIns);
-    return pandaIns;
 }
 
 static int ParseVariablesDebugInfo(const Json::Value &function, panda::pandasm::Function &pandaFunc)
@@ -553,16 +685,23 @@ panda::pandasm::Function GetFunctionDefintion(const Json::Value &function)
 
 static void ParseFunctionInstructions(const Json::Value &function, panda::pandasm::Function &pandaFunc)
 {
-    if (function.isMember("i") && function["i"].isArray()) {
-        auto ins = function["i"];
-        for (Json::ArrayIndex i = 0; i < ins.size(); ++i) {
-            if (!ins[i].isObject()) {
-                continue;
-            }
+    const Json::Value *ins = FindMember(function, "i");
+    if (ins == nullptr || !ins->isArray()) {
+        return;
+    }
+
+    // instructions are decoded in place, without temporary copies of the JSON or pandasm values
+    pandaFunc.ins.reserve(pandaFunc.ins.size() + ins->size());
+    for (const auto &it : *ins) {
+        if (!it.isObject()) {
+            continue;
+        }
+
+        auto &paIns = pandaFunc.ins.emplace_back();
+        ParseInstruction(it, paIns);
 
-            auto paIns = ParseInstruction(ins[i]);
+        if (GetDebugLog()) {
             Logd("instruction:\t%s", paIns.ToString().c_str());
-            pandaFunc.ins.push_back(paIns);
         }
     }
 }
@@ -16,10 +16,8 @@
 #ifndef TS2PANDA_TS2ABC_TS2ABC_H_
 #define TS2PANDA_TS2ABC_TS2ABC_H_
 
-#include <codecvt>
 #include <cstdarg>
 #include <iostream>
-#include <locale>
 #include <string>
 #include <unistd.h>
 
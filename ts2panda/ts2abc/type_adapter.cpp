@@ -15,22 +15,66 @@
 
 #include "type_adapter.h"
 #include "assembler/meta.h"
+#include "os/thread.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
 
 namespace ts2abc_type_adapter {
 void TypeAdapter::AdaptTypeForProgram(panda::pandasm::Program *prog) const
 {
+    std::vector<panda::pandasm::Function *> funcs;
+    funcs.reserve(prog->function_table.size());
     for (auto &[name, func] : prog->function_table) {
-        if (ShouldDisplayTypeInfo()) {
-            std::cout << "Handle types for funtion: " << name << "\n";
+        funcs.push_back(&func);
+    }
+
+    // functions are adapted independently, keep the serial order only when the types are displayed
+    size_t thread_count = GetThreadCount(funcs.size());
+    if (ShouldDisplayTypeInfo() || thread_count <= 1) {
+        for (auto *func : funcs) {
+            if (ShouldDisplayTypeInfo()) {
+                std::cout << "Handle types for funtion: " << func->name << "\n";
+            }
+            AdaptTypeForFunction(func);
         }
-        AdaptTypeForFunction(&func);
+        return;
+    }
+
+    std::atomic<size_t> next {0};
+    std::vector<panda::os::thread::native_handle_type> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; i++) {
+        threads.push_back(panda::os::thread::ThreadStart(AdaptTypeWorker, this, &funcs, &next));
+    }
+
+    AdaptTypeWorker(this, &funcs, &next);
+
+    void *retval = nullptr;
+    for (const auto handle_id : threads) {
+        panda::os::thread::ThreadJoin(handle_id, &retval);
+    }
+}
+
+void TypeAdapter::AdaptTypeWorker(const TypeAdapter *adapter, std::vector<panda::pandasm::Function *> *funcs,
+                                  std::atomic<size_t> *next)
+{
+    for (size_t i = next->fetch_add(1); i < funcs->size(); i = next->fetch_add(1)) {
+        adapter->AdaptTypeForFunction((*funcs)[i]);
     }
 }
 
+size_t TypeAdapter::GetThreadCount(size_t func_count) const
+{
+    size_t thread_count = thread_count_ != 0 ? thread_count_ : std::thread::hardware_concurrency();
+    return std::min(thread_count, func_count);
+}
+
 void TypeAdapter::AdaptTypeForFunction(panda::pandasm::Function *func) const
 {
     const auto &annos = func->metadata->GetAnnotations();
-    std::unordered_map<int32_t, int32_t> vreg_type_map;
+    VregTypeTable vreg_type_table;
     size_t anno_idx = 0;
     size_t ele_idx = 0;
     for (; anno_idx < annos.size(); anno_idx++) {
@@ -49,16 +93,25 @@ void TypeAdapter::AdaptTypeForFunction(panda::pandasm::Function *func) const
             const auto &values = array_value->GetAsArray()->GetValues();
             size_t i = 0;
             while (i < values.size()) {
-                auto vreg = static_cast<int32_t>(values[i++].GetValue<uint32_t>());
+                auto vreg = values[i++].GetValue<uint32_t>();
                 auto type = static_cast<int32_t>(values[i++].GetValue<uint32_t>());
-                vreg_type_map.emplace(vreg, type);
+                // instructions can only address 16-bit registers, so other vregs never get their type
+                if (vreg > std::numeric_limits<uint16_t>::max()) {
+                    continue;
+                }
+                if (vreg >= vreg_type_table.size()) {
+                    vreg_type_table.resize(vreg + 1);
+                }
+                if (!vreg_type_table[vreg].has_value()) {
+                    vreg_type_table[vreg] = type;
+                }
             }
             break;
         }
         break;
     }
-    if (!vreg_type_map.empty()) {
-        HandleTypeForFunction(func, anno_idx, ele_idx, vreg_type_map);
+    if (!vreg_type_table.empty()) {
+        HandleTypeForFunction(func, anno_idx, ele_idx, vreg_type_table);
     }
 }
 
@@ -68,10 +121,10 @@ static bool MaybeArg(const panda::pandasm::Function *func, size_t idx)
 }
 
 void TypeAdapter::HandleTypeForFunction(panda::pandasm::Function *func, size_t anno_idx, size_t ele_idx,
-                                        const std::unordered_map<int32_t, int32_t> &vreg_type_map) const
+                                        const VregTypeTable &vreg_type_table) const
 {
-    std::unordered_map<int32_t, int32_t> order_type_map;
-    std::vector<int32_t> finished_vregs;
+    OrderTypeList order_type_list;
+    std::vector<bool> finished_vregs(vreg_type_table.size(), false);
     int32_t order = 0;
     for (size_t i = 0; i < func->ins.size(); i++) {
         const auto &insn = func->ins[i];
@@ -89,12 +142,11 @@ void TypeAdapter::HandleTypeForFunction(panda::pandasm::Function *func, size_t a
             if (vreg >= func->params.size() || arg < func->regs_num) {
                 continue;  // not arg
             }
-            auto it = vreg_type_map.find(vreg);
-            if (it != vreg_type_map.end()) {
-                ASSERT(std::find(finished_vregs.begin(), finished_vregs.end(), vreg) == finished_vregs.end());
+            if (vreg < vreg_type_table.size() && vreg_type_table[vreg].has_value()) {
+                ASSERT(!finished_vregs[vreg]);
                 int32_t arg_order = func->regs_num - arg - 1;
-                order_type_map.emplace(arg_order, it->second);
-                finished_vregs.emplace_back(vreg);
+                order_type_list.emplace_back(arg_order, *vreg_type_table[vreg]);
+                finished_vregs[vreg] = true;
             }
             continue;
         }
@@ -103,19 +155,17 @@ void TypeAdapter::HandleTypeForFunction(panda::pandasm::Function *func, size_t a
         ASSERT(insn.opcode == panda::pandasm::Opcode::STA_DYN);
         ASSERT(!insn.regs.empty());
         auto vreg = insn.regs[0];
-        auto it = vreg_type_map.find(vreg);
-        if (it != vreg_type_map.end() &&
-                  std::find(finished_vregs.begin(), finished_vregs.end(), vreg) == finished_vregs.end()) {
-            order_type_map.emplace(order - 1, it->second);
-            finished_vregs.emplace_back(vreg);
+        if (vreg < vreg_type_table.size() && vreg_type_table[vreg].has_value() && !finished_vregs[vreg]) {
+            order_type_list.emplace_back(order - 1, *vreg_type_table[vreg]);
+            finished_vregs[vreg] = true;
         }
     }
 
-    UpdateTypeAnnotation(func, anno_idx, ele_idx, order_type_map);
+    UpdateTypeAnnotation(func, anno_idx, ele_idx, order_type_list);
 }
 
 void TypeAdapter::UpdateTypeAnnotation(panda::pandasm::Function *func, size_t anno_idx, size_t ele_idx,
-                                       const std::unordered_map<int32_t, int32_t> &order_type_map) const
+                                       const OrderTypeList &order_type_list) const
 {
     ASSERT(anno_idx <= func->metadata->GetAnnotations().size());
     if (anno_idx == func->metadata->GetAnnotations().size()) {
@@ -129,7 +179,8 @@ void TypeAdapter::UpdateTypeAnnotation(panda::pandasm::Function *func, size_t an
     using ArrayValue = panda::pandasm::ArrayValue;
     using ScalarValue = panda::pandasm::ScalarValue;
     std::vector<ScalarValue> elements;
-    for (const auto &[order, type] : order_type_map) {
+    elements.reserve(order_type_list.size() * 2);  // 2: order and type
+    for (const auto &[order, type] : order_type_list) {
         ScalarValue insn_order(ScalarValue::Create<panda::pandasm::Value::Type::I32>(order));
         elements.emplace_back(std::move(insn_order));
         ScalarValue insn_type(ScalarValue::Create<panda::pandasm::Value::Type::I32>(type));
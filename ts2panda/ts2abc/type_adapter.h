@@ -19,12 +19,16 @@
 #include "assembler/assembly-program.h"
 #include "assembler/assembly-function.h"
 
+#include <atomic>
+#include <optional>
+
 namespace ts2abc_type_adapter {
 class TypeAdapter {
 public:
     TypeAdapter() {};
     ~TypeAdapter() {};
-    explicit TypeAdapter(bool display) : display_typeinfo_(display) {};
+    explicit TypeAdapter(bool display, size_t thread_count = 0)
+        : display_typeinfo_(display), thread_count_(thread_count) {};
 
     static constexpr const char* TSTYPE_ANNO_RECORD_NAME = "_ESTypeAnnotation";
     static constexpr const char* TSTYPE_ANNO_ELEMENT_NAME = "_TypeOfInstruction";
@@ -37,12 +41,20 @@ public:
     void AdaptTypeForProgram(panda::pandasm::Program *prog) const;
 
 private:
+    // types of vregs indexed by vreg number, and (instruction order, type) pairs in instruction order
+    using VregTypeTable = std::vector<std::optional<int32_t>>;
+    using OrderTypeList = std::vector<std::pair<int32_t, int32_t>>;
+
+    static void AdaptTypeWorker(const TypeAdapter *adapter, std::vector<panda::pandasm::Function *> *funcs,
+                                std::atomic<size_t> *next);
+    size_t GetThreadCount(size_t func_count) const;
     void AdaptTypeForFunction(panda::pandasm::Function *func) const;
     void HandleTypeForFunction(panda::pandasm::Function *func, size_t anno_idx, size_t ele_idx,
-                               const std::unordered_map<int32_t, int32_t> &vreg_type_map) const;
+                               const VregTypeTable &vreg_type_table) const;
     void UpdateTypeAnnotation(panda::pandasm::Function *func, size_t anno_idx, size_t ele_idx,
-                              const std::unordered_map<int32_t, int32_t> &order_type_map) const;
+                              const OrderTypeList &order_type_list) const;
     bool display_typeinfo_ = false;
+    size_t thread_count_ = 0;
 };
 }  // namespace ts2abc_type_adapter
 